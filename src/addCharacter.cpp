@@ -4,12 +4,17 @@ Description: Implementation of the AddCharacter class, which allows users to cre
 Authors: Josh Park, Chanu Lee, Carson Treece
 Other Sources: ...
 Date Created: 10/24/2024
-Last Modified: 12/4/2024
+Last Modified: 10/17/2026
 */
 
 #include "addCharacter.h"
 #include "characterSelect.h"
+#include "characterIndex.h"
+#include "characterStorage.h"
+#include "notesStore.h"
 #include "utils.h"
+#include "thumbnailCache.h"
+#include "fuzzyCompleter.h"
 
 #include <iostream>
 
@@ -47,15 +52,15 @@ Portrait::Portrait(const QString &type, const QString &selection, QWidget *paren
 
 void Portrait::getImage(const QString &selection)
 {
-	// Attempt to retrieve a picture file from the assets folder based on the widget type and combo box selection
-	QPixmap image(QDir::currentPath() + "/src/assets/" + *this->typeWidget + "/" + selection.toLower() + ".png", "-d");
+	// Attempt to retrieve a picture file from the assets folder based on the widget type and combo box selection,
+	// the scaled copy is cached so flipping through the combo box never decodes the full image again
+	QPixmap image = ThumbnailCache::pixmap(QDir::currentPath() + "/src/assets/" + *this->typeWidget + "/" + selection.toLower() + ".png", QSize(450, 600));
 	if (image.isNull())
 	{
 		this->setText("Image not available");
 	}
 	else
 	{
-		image = image.scaled(450, 600, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 		this->setPixmap(image);
 	}
 }
@@ -109,7 +114,7 @@ void AddCharacter::createCharacter()
 
 	// creates the character directory
 	QDir dir;
-	if (dir.exists(charPath))
+	if (dir.exists(charPath) || CharacterStorage::instance().exists(characterName, "character.csv"))
 	{
 		QMessageBox::warning(this, "Character Exists",
 							 "A character with this name already exists!"); // This is a warning message if the character already exists
@@ -117,34 +122,23 @@ void AddCharacter::createCharacter()
 	}
 	else
 	{
-		if (dir.mkpath(charPath))
-		{
-			// Create the notes and databases files inside the folder
-			QFile notesFile(charPath + "/notes.json"); // Create a notes file
-			if (notesFile.open(QIODevice::WriteOnly | QIODevice::Text))
-			{
-				QTextStream out(&notesFile);
-				// Add default content to notes.txt
-				out << "{" << Qt::endl;
-				out << "\t\"sortPreference\": \"lastUpdated\"," << Qt::endl;
-				out << "\t\"notes\": [" << Qt::endl;
-				out << "\t\t" << Qt::endl;
-				out << "\t]" << Qt::endl;
-				out << "}" << Qt::endl;
-				notesFile.close(); // Close the file
-			}
-		}
-		else
+		// The folder holds the character's portrait whatever storage their records are in
+		if (!dir.mkpath(charPath))
 		{
 			QMessageBox::warning(this, "Error", "Failed to create character directory."); // This is a warning message if the directory creation fails
+			return;
 		}
 	}
 
-	QFile characterFile(charPath + "/character.csv");
+	// Every file of the new character, saved together at the end
+	QMap<QString, QByteArray> records;
+
+	// Start with an empty notes index, each note gets its own record when it is created
+	records.insert("notes.index", NotesStore::emptyIndex());
 
-	if (characterFile.open(QIODevice::WriteOnly | QIODevice::Text))
 	{
-		QTextStream out(&characterFile);
+		QString characterContents;
+		QTextStream out(&characterContents);
 		// Stats
 		QString strength = QString::number(this->baseStatsWidget->getStrength());
 		QString dexterity = QString::number(this->baseStatsWidget->getDexterity());
@@ -262,28 +256,33 @@ void AddCharacter::createCharacter()
 		out << listToCommaString(languages) + "\n";
 		out << listToCommaString(armorWeaponProficiencies) + "\n";
 		out << numPlatCoins + "," + numGoldCoins + "," + numSilverCoins + "," + numCopperCoins + "\n";
-		characterFile.close();
+		out.flush();
+		records.insert("character.csv", characterContents.toUtf8());
 
 		// Create the inventory file
-		QFile inventoryFile(charPath + "/inventory.csv"); // Create an inventory file
-		if (inventoryFile.open(QIODevice::WriteOnly | QIODevice::Text))
-		{											  // Open the file
-			QTextStream inventoryOut(&inventoryFile); // Create a text stream
-
-			for (const QString &item : filteredInventory)
-			{								  // For each item in the list
-				inventoryOut << item << "\n"; // Write the item to the file
-			}
-
-			inventoryFile.close(); // Close the file
+		QByteArray inventoryContents;
+		for (const QString &item : filteredInventory)
+		{
+			inventoryContents += item.toUtf8() + "\n"; // Write each item to the file
 		}
+		records.insert("inventory.csv", inventoryContents);
 
 		if (this->classWidget->isSpellcaster())
 		{
-			this->spellsWidget->recordSpells(charPath);
+			records.insert("spells.csv", this->spellsWidget->recordSpells());
 		}
-		emit this->createdCharacter();
 	}
+
+	// Either the whole character is saved or none of it is
+	if (!CharacterStorage::instance().write(characterName, records))
+	{
+		QMessageBox::warning(this, "Error", "Failed to save character " + characterName + ".");
+		return;
+	}
+
+	// Added to the index before the signal so the character select list already has them
+	CharacterIndex::instance().update(characterName);
+	emit this->createdCharacter();
 }
 
 /**
@@ -635,57 +634,21 @@ BackgroundWidget::BackgroundWidget(QWidget *parent) : QWidget(parent)
  */
 void BackgroundWidget::loadBackgrounds()
 {
-	QFile file("data/databases/Backgrounds.tsv"); // read in the file
-	qDebug() << "Current working directory:" << QDir::currentPath();
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-	{ // error checking for debugging
-		std::cerr << "Failed to open file" << std::endl;
-		return;
-	}
-
-	QTextStream in(&file); // read in the file
-	bool isHeader = true;  // our first line is a header
-
-	while (!in.atEnd())
-	{
-		QString line = in.readLine(); // read in the line
-		if (isHeader)
-		{
-			isHeader = false; // we are no longer on the header
-			continue;		  // skip the header
-		}
-
-		QStringList fields = line.split("\t"); // split the line by \t
-		if (fields.size() < 8)
-			continue; // ensure we get all the fields
-
-		BackgroundInfo info = {
-			fields[1], // page
-			fields[2], // description
-			fields[3], // skill proficiencies
-			fields[4], // tool proficiencies
-			fields[5], // languages
-			fields[6], // equipment
-			fields[7], // feature
-			fields[8]  // feature description
-		};
-
-		QString name = fields[0];		   // name of the background
-		backgrounds[name] = info;		   // add the background to the map
-		backgroundComboBox->addItem(name); // add the background to the combo box
-	}
+	// Backgrounds.tsv is parsed once by the shared database, we only need the names here
+	backgroundComboBox->addItems(ReferenceDatabase::instance().backgroundNames());
 }
 
 void BackgroundWidget::updateBackgroundInfo(const QString &backgroundName)
 {
-	if (!backgrounds.contains(backgroundName))
+	const BackgroundInfo *background = ReferenceDatabase::instance().backgroundInfo(backgroundName);
+	if (!background)
 	{
 		qWarning() << "Background not found:" << backgroundName;
 		return;
 	}
 
 	// get info
-	BackgroundInfo info = backgrounds[backgroundName];
+	const BackgroundInfo &info = *background;
 
 	// make labels
 	nameAndPageLabel->setText(backgroundName + " (Page " + info.page + ")");
@@ -862,6 +825,11 @@ void InventoryWidget::addItem()
 	QLabel *textboxLabel = new QLabel("Name:", &popup); // label for textbox
 	QLineEdit *itemName = new QLineEdit(&popup);
 
+	// complete the name from Items.tsv, homebrew items can still be typed in
+	const ItemCompendium &compendium = ReferenceDatabase::instance().itemCompendium();
+	FuzzyCompleter *completer = new FuzzyCompleter(compendium.names(), &popup);
+	completer->attach(itemName);
+
 	// create the buttons for the popup
 	QPushButton *popupConfirm = new QPushButton("Confirm", &popup); // creates the confirm button
 	QPushButton *popupCancel = new QPushButton("Cancel", &popup);	// creates the cancel button
@@ -901,7 +869,9 @@ void InventoryWidget::addItem()
 
 	if (popup.result() == QDialog::Accepted)
 	{
-		this->items->addItem(itemName->text());
+		// use the compendium's spelling for known items
+		int id = compendium.find(itemName->text());
+		this->items->addItem(id >= 0 ? compendium.item(id).name : itemName->text());
 	}
 }
 
@@ -4,7 +4,7 @@ Description: Implementation of the AddCharacter class, which allows users to cre
 Authors: Josh Park, Chanu Lee, Carson Treece
 Other Sources: ...
 Date Created: 10/24/2024
-Last Modified: 12/4/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef ADD_CHARACTER_H
@@ -22,6 +22,8 @@ Last Modified: 12/4/2024
 #include <QPushButton>
 #include <QRadioButton>
 
+#include "referenceDatabase.h"
+
 class UpComboBox;
 class Portrait;
 class StartWidget;
@@ -127,31 +129,8 @@ private slots:
 	void nextPage();
 };
 
-// This is a very hastily put together solution for replacing values
-// replace this with a tsv file later
-inline QList<QString> simpleMelee = {"Club", "Dagger", "Greatclub", "Handaxe", "Javelin", "Light Hammer", "Mace", "Quarterstaff", "Sickle", "Spear"};
-inline QList<QString> simpleRanged = {"Light Crossbow", "Dart", "Shortbow", "Sling"};
-inline QList<QString> martialMelee = {"Battleaxe", "Flail", "Glaive", "Greataxe", "Greatsword", "Halberd"
-																								"Lance",
-									  "Longsword", "Maul", "Moerningstar", "Pike", "Rapier", "Scimitar", "Shortsword", "Trident", "War pick", "Warhammer", "Whip"};
-inline QList<QString> martialRanged = {"Blowgun", "Hand Crossbow", "Heavy Crossbow", "Longbow", "Net"};
 inline QList<QString> allSkills = {"Acrobatics", "Animal Handling", "Arcana", "Athletics", "Deception", "History", "Intimidation", "Investigation", "Medicine", "Nature", "Perception", "Performance", "Persuasion", "Religion", "Sleight of Hand", "Stealth", "Survival"};
 
-struct ClassInfo
-{
-	QString book;
-	QString page;
-	QList<QString> *armorProficiencies;
-	QList<QString> *weaponProficiencies;
-	QList<QString> *toolProficiencies;
-	QList<QString> *savingThrows;
-	int numSkills;
-	QList<QString> *skillProficiencies;
-	QList<QList<QString> *> *equipmentChoices;
-	QList<QString> *givenEquipment;
-	QString summary;
-};
-
 class ClassWidget : public QWidget
 {
 	Q_OBJECT
@@ -160,15 +139,14 @@ public:
 	bool isSpellcaster() { return this->spellcasters.contains(this->getClass()); }
 	// function for getting which class is selected
 	QString getClass();
-	QList<QString> *getArmorProficincies();
-	QList<QString> *getWeaponProficincies();
-	QList<QString> *getToolProficincies();
-	QList<QString> *getSavingThrows();
+	const QList<QString> *getArmorProficincies();
+	const QList<QString> *getWeaponProficincies();
+	const QList<QString> *getToolProficincies();
+	const QList<QString> *getSavingThrows();
 	QList<QString> *getSkillProficincies();
 	QList<QString> *getItems();
 
 private:
-	QMap<QString, ClassInfo *> classes;
 	QLabel *header;
 	Portrait *portrait;
 	QLabel *summary;
@@ -185,6 +163,7 @@ private:
 	QLabel *givenEquipment;
 	UpComboBox *classComboBox;
 	QList<QString> spellcasters = {"Bard", "Cleric", "Druid", "Paladin", "Ranger", "Sorcerer", "Warlock", "Wizard"};
+	const ClassInfo *currentClassInfo();
 	void loadClasses();
 private slots:
 	void backPage();
@@ -194,24 +173,6 @@ private slots:
 	void proficiencyDisableSkills();
 };
 
-struct SubRaceInfo
-{
-	QString abilityScoreIncrease;
-	QString size;
-	QString speed;
-	QString languages;
-	QList<QString> *abilities;
-};
-
-struct RaceInfo
-{
-	QString book;
-	QString page;
-	QString summary;
-	bool subRacesExist;
-	QMap<QString, SubRaceInfo *> subRaces;
-};
-
 class RaceWidget : public QWidget
 {
 	Q_OBJECT
@@ -224,12 +185,9 @@ public:
 	QString getSize();
 	QString getSpeed();
 	QString getLanguages();
-	QList<QString> *getAbilities();
+	const QList<QString> *getAbilities();
 
 private:
-	// Add a map to store background data
-	QMap<QString, RaceInfo *> races;
-
 	// Add new private members for displaying race info
 	QLabel *header;
 	Portrait *portrait;
@@ -245,6 +203,7 @@ private:
 	QLabel *abilities;
 
 	// Add declarations for new methods
+	const SubRaceInfo *currentSubRaceInfo();
 	void loadRaces();
 
 private slots:
@@ -254,18 +213,6 @@ private slots:
 	void updateSubRaceInfo(const QString &subRaceName);
 };
 
-struct BackgroundInfo
-{
-	QString page;
-	QString description;
-	QString skillProficiency;
-	QString toolProficiency;
-	QString languages;
-	QString equipment;
-	QString feature;
-	QString featureDescription;
-};
-
 class BackgroundWidget : public QWidget
 {
 	Q_OBJECT
@@ -293,9 +240,6 @@ private:
 	QList<QString> toolProficiencies;
 	QList<QString> items;
 
-	// Add a map to store background data
-	QMap<QString, BackgroundInfo> backgrounds;
-
 	// Add declarations for new methods
 	void loadBackgrounds();
 	void updateBackgroundInfo(const QString &backgroundName);
@@ -313,35 +257,18 @@ public:
 	explicit SpellsWidget(QWidget *parent = 0);
 
 private:
-	struct SpellInfo
-	{
-		QString book;
-		int page;
-		int level;
-		QString school;
-		QString time;
-		int minRange;
-		int maxRange;
-		bool verbal;
-		bool somatic;
-		bool material;
-		QString duration;
-		bool concentration;
-		bool ritual;
-		QString description;
-	};
-
 	QLabel *header;
 	QListWidget *spellsList;
 	QPushButton *addSpellButton;
 	QPushButton *removeSpellButton;
 
-	QMap<QString, SpellInfo *> *spells;
+	QMap<QString, SpellRecord> *spells;
 
 	int numSpells();
 public slots:
 	void updateNumSpells();
-	void recordSpells(QString charPath);
+	// Contents of spells.csv for the chosen spells
+	QByteArray recordSpells();
 private slots:
 	void backPage();
 	void nextPage();
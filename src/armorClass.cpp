@@ -0,0 +1,146 @@
+/*
+Name: armorClass.cpp
+Description: A character's Armor Class from the armor and shields they have equipped, the armor type's
+			 limit on the Dexterity bonus, and Unarmored Defense from their class. Items are equipped and
+			 unequipped one at a time so a toggle in the inventory never means reading the inventory again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "armorClass.h"
+#include "referenceDatabase.h"
+
+#include <QStringList>
+
+static const int dexterity = 1;
+
+// Light armor adds all of Dex, medium armor at most +2 and heavy armor none of it
+static int maxDexterityBonus(const ItemInfo &armor)
+{
+	if (armor.type == "Medium Armor")
+	{
+		return 2;
+	}
+	if (armor.type == "Heavy Armor")
+	{
+		return 0;
+	}
+	return -1; // no limit
+}
+
+static void change(QHash<int, int> &counts, int id, int amount)
+{
+	int count = counts.value(id) + amount;
+	if (count > 0)
+	{
+		counts.insert(id, count);
+	}
+	else
+	{
+		counts.remove(id);
+	}
+}
+
+ArmorClass::UnarmoredDefense ArmorClass::unarmoredDefense(const QString &className, const QString &subclass, int level)
+{
+	static const QStringList abilities = {"Strength", "Dexterity", "Constitution", "Intelligence", "Wisdom", "Charisma"};
+
+	UnarmoredDefense defense;
+	for (const FeatureInfo &feature : ReferenceDatabase::instance().features(className))
+	{
+		if (feature.featureName != "Unarmored Defense" || feature.level > level ||
+			(feature.subClass != "Base" && feature.subClass != subclass))
+		{
+			continue;
+		}
+
+		// The description names the ability, ex. "10 + your Dexterity modifier + your Wisdom modifier"
+		for (int i = 0; i < abilities.size(); i++)
+		{
+			if (i != dexterity && feature.description.contains(abilities[i] + " modifier"))
+			{
+				defense.ability = i;
+				break;
+			}
+		}
+		defense.allowsShield = feature.description.contains("can use a shield", Qt::CaseInsensitive);
+		break;
+	}
+	return defense;
+}
+
+void ArmorClass::equip(const QString &itemName)
+{
+	const ItemCompendium &items = ReferenceDatabase::instance().itemCompendium();
+	int id = items.find(itemName);
+	if (id < 0)
+	{
+		return;
+	}
+	if (items.item(id).isArmor())
+	{
+		change(this->armor, id, 1);
+	}
+	else if (items.item(id).isShield())
+	{
+		change(this->shields, id, 1);
+	}
+}
+
+void ArmorClass::unequip(const QString &itemName)
+{
+	const ItemCompendium &items = ReferenceDatabase::instance().itemCompendium();
+	int id = items.find(itemName);
+	if (id < 0)
+	{
+		return;
+	}
+	if (items.item(id).isArmor())
+	{
+		change(this->armor, id, -1);
+	}
+	else if (items.item(id).isShield())
+	{
+		change(this->shields, id, -1);
+	}
+}
+
+void ArmorClass::clearEquipment()
+{
+	this->armor.clear();
+	this->shields.clear();
+}
+
+int ArmorClass::value() const
+{
+	const ItemCompendium &items = ReferenceDatabase::instance().itemCompendium();
+	int dex = this->modifier(dexterity);
+
+	// Only one suit of armor can be worn, so if more are marked equipped count the best of them
+	int armorClass = 0;
+	for (auto it = this->armor.constBegin(); it != this->armor.constEnd(); ++it)
+	{
+		const ItemInfo &armor = items.item(it.key());
+		int cap = maxDexterityBonus(armor);
+		armorClass = qMax(armorClass, armor.armorClass + (cap < 0 ? dex : qMin(dex, cap)));
+	}
+
+	if (this->armor.isEmpty())
+	{
+		armorClass = 10 + dex;
+		if (this->unarmored.ability >= 0 && (this->unarmored.allowsShield || this->shields.isEmpty()))
+		{
+			armorClass += qMax(0, this->modifier(this->unarmored.ability)); // a character can always choose 10 + Dex
+		}
+	}
+
+	// Likewise only one shield is carried at a time
+	int shieldBonus = 0;
+	for (auto it = this->shields.constBegin(); it != this->shields.constEnd(); ++it)
+	{
+		shieldBonus = qMax(shieldBonus, items.item(it.key()).armorClass);
+	}
+	return armorClass + shieldBonus;
+}
@@ -0,0 +1,53 @@
+/*
+Name: armorClass.h
+Description: A character's Armor Class from the armor and shields they have equipped, the armor type's
+			 limit on the Dexterity bonus, and Unarmored Defense from their class. Items are equipped and
+			 unequipped one at a time so a toggle in the inventory never means reading the inventory again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef ARMORCLASS_H
+#define ARMORCLASS_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class ArmorClass
+{
+public:
+	// A second ability modifier added to 10 + Dex while no armor is worn, ex. Constitution for a Barbarian
+	struct UnarmoredDefense
+	{
+		int ability = -1; // index into the ability modifiers, -1 if the class has no Unarmored Defense
+		bool allowsShield = false;
+	};
+
+	// Finds Unarmored Defense in the class's features, only once the character has reached its level
+	static UnarmoredDefense unarmoredDefense(const QString &className, const QString &subclass, int level);
+
+	// Modifiers in character.csv order, Str, Dex, Con, Int, Wis, Cha
+	void setAbilityModifiers(const QList<int> &modifiers) { this->modifiers = modifiers; }
+	void setUnarmoredDefense(const UnarmoredDefense &defense) { this->unarmored = defense; }
+
+	// Items that are not armor or shields in Items.tsv are ignored
+	void equip(const QString &itemName);
+	void unequip(const QString &itemName);
+	void clearEquipment();
+
+	int value() const;
+
+private:
+	int modifier(int ability) const { return this->modifiers.value(ability); }
+
+	QList<int> modifiers;
+	UnarmoredDefense unarmored;
+	// Item ids in the item compendium to the number of them equipped, usually one armor and one shield
+	QHash<int, int> armor;
+	QHash<int, int> shields;
+};
+
+#endif // ARMORCLASS_H
@@ -0,0 +1,120 @@
+/*
+Name: autosaveEngine.cpp
+Description: Decides when an edited document is saved. Typing marks the open section dirty, and it is saved
+			 once the user pauses, when the section or page is left, or when an edit has waited for the
+			 maximum staleness. Nothing is written while nothing changes.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "autosaveEngine.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QTextDocument>
+#include <QTextStream>
+
+static const int defaultIdleDelay = 2000;
+static const int defaultMaxStaleness = 30; // seconds
+
+static QString maxStalenessPath()
+{
+	return QDir::currentPath() + "/data/autosave.txt";
+}
+
+AutosaveEngine::AutosaveEngine(Saver saver, QObject *parent)
+	: QObject(parent), saver(std::move(saver))
+{
+	this->idleTimer.setSingleShot(true);
+	this->idleTimer.setInterval(defaultIdleDelay);
+	this->staleTimer.setSingleShot(true);
+	this->staleTimer.setInterval(savedMaxStaleness() * 1000);
+	connect(&this->idleTimer, &QTimer::timeout, this, &AutosaveEngine::flush);
+	connect(&this->staleTimer, &QTimer::timeout, this, &AutosaveEngine::flush);
+}
+
+void AutosaveEngine::watch(QTextDocument *document)
+{
+	connect(document, &QTextDocument::contentsChanged, this, &AutosaveEngine::markDirty);
+}
+
+void AutosaveEngine::begin(const QString &section)
+{
+	this->current = section;
+	this->dirty = false;
+	this->idleTimer.stop();
+	this->staleTimer.stop();
+}
+
+void AutosaveEngine::setIdleDelay(int msec)
+{
+	this->idleTimer.setInterval(msec);
+}
+
+void AutosaveEngine::setMaxStaleness(int msec)
+{
+	this->staleTimer.setInterval(msec);
+}
+
+int AutosaveEngine::savedMaxStaleness()
+{
+	QFile file(maxStalenessPath());
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		bool ok = false;
+		int seconds = QTextStream(&file).readLine().trimmed().toInt(&ok);
+		if (ok && seconds > 0)
+		{
+			return seconds;
+		}
+	}
+	return defaultMaxStaleness;
+}
+
+void AutosaveEngine::setSavedMaxStaleness(int seconds)
+{
+	QFile file(maxStalenessPath());
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		QTextStream(&file) << seconds;
+	}
+	else
+	{
+		qWarning() << "Could not save the autosave interval:" << file.errorString();
+	}
+}
+
+void AutosaveEngine::markDirty()
+{
+	// With no section open the document is only being cleared
+	if (this->current.isEmpty())
+	{
+		return;
+	}
+
+	// The pause restarts with every keystroke, the staleness clock only starts with the first one
+	this->idleTimer.start();
+	if (!this->dirty)
+	{
+		this->dirty = true;
+		this->staleTimer.start();
+	}
+}
+
+void AutosaveEngine::flush()
+{
+	this->idleTimer.stop();
+	this->staleTimer.stop();
+	if (!this->dirty || this->current.isEmpty())
+	{
+		this->skipped++;
+		return;
+	}
+
+	this->dirty = false;
+	this->saver(this->current);
+	this->performed++;
+}
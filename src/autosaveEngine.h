@@ -0,0 +1,67 @@
+/*
+Name: autosaveEngine.h
+Description: Decides when an edited document is saved. Typing marks the open section dirty, and it is saved
+			 once the user pauses, when the section or page is left, or when an edit has waited for the
+			 maximum staleness. Nothing is written while nothing changes.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef AUTOSAVEENGINE_H
+#define AUTOSAVEENGINE_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+class QTextDocument;
+
+class AutosaveEngine : public QObject
+{
+	Q_OBJECT
+
+public:
+	using Saver = std::function<void(const QString &section)>;
+
+	explicit AutosaveEngine(Saver saver, QObject *parent = nullptr);
+
+	// Marks the section dirty whenever the document changes
+	void watch(QTextDocument *document);
+
+	// The section the document now holds, anything loaded into it up to here is not an edit
+	void begin(const QString &section);
+	const QString &section() const { return this->current; }
+	bool isDirty() const { return this->dirty; }
+
+	// How long typing has to pause before saving, and the longest an edit waits regardless
+	void setIdleDelay(int msec);
+	void setMaxStaleness(int msec);
+	int idleDelay() const { return this->idleTimer.interval(); }
+	int maxStaleness() const { return this->staleTimer.interval(); }
+
+	// The maximum staleness picked on the settings page, in seconds
+	static int savedMaxStaleness();
+	static void setSavedMaxStaleness(int seconds);
+
+	// Flushes that wrote the section, and ones that found nothing to write
+	int savesPerformed() const { return this->performed; }
+	int savesSkipped() const { return this->skipped; }
+
+public slots:
+	void markDirty();
+	void flush();
+
+private:
+	Saver saver;
+	QString current;
+	bool dirty = false;
+	QTimer idleTimer;
+	QTimer staleTimer;
+	int performed = 0;
+	int skipped = 0;
+};
+
+#endif // AUTOSAVEENGINE_H
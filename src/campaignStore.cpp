@@ -0,0 +1,272 @@
+/*
+Name: campaignStore.cpp
+Description: Keeps every character's records in one SQLite campaign file, one row per record keyed by the
+			 character and record name, so listing, opening, and saving a character are indexed lookups and
+			 a save of several records is a single transaction.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "campaignStore.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSqlError>
+#include <QVariant>
+
+CampaignStore::CampaignStore(const QString &path)
+	: connectionName("campaign-" + QString::number(reinterpret_cast<quintptr>(this)))
+{
+	if (!QSqlDatabase::isDriverAvailable("QSQLITE"))
+	{
+		qWarning() << "The SQLite driver is not available";
+		return;
+	}
+
+	QDir().mkpath(QFileInfo(path).absolutePath());
+	this->database = QSqlDatabase::addDatabase("QSQLITE", this->connectionName);
+	this->database.setDatabaseName(path);
+	if (!this->database.open())
+	{
+		qWarning() << "Could not open campaign file" << path << this->database.lastError().text();
+		return;
+	}
+
+	// The write ahead log turns each save into an append instead of rewriting pages in place
+	QSqlQuery setup(this->database);
+	setup.exec("PRAGMA journal_mode=WAL");
+	setup.exec("PRAGMA synchronous=NORMAL");
+	if (!setup.exec("CREATE TABLE IF NOT EXISTS records ("
+					"character TEXT NOT NULL, "
+					"record TEXT NOT NULL, "
+					"data BLOB NOT NULL, "
+					"modified INTEGER NOT NULL, "
+					"PRIMARY KEY (character, record)) WITHOUT ROWID"))
+	{
+		qWarning() << "Could not create the campaign tables" << setup.lastError().text();
+		return;
+	}
+
+	// Counts characters being added and removed, a record that is the first or last one of its character
+	if (!setup.exec("CREATE TABLE IF NOT EXISTS generation (value INTEGER NOT NULL)") ||
+		!setup.exec("INSERT INTO generation (value) SELECT 0 WHERE NOT EXISTS (SELECT 1 FROM generation)") ||
+		!setup.exec("CREATE TRIGGER IF NOT EXISTS characterAdded AFTER INSERT ON records "
+					"WHEN (SELECT COUNT(*) FROM records WHERE character = NEW.character) = 1 "
+					"BEGIN UPDATE generation SET value = value + 1; END") ||
+		!setup.exec("CREATE TRIGGER IF NOT EXISTS characterRemoved AFTER DELETE ON records "
+					"WHEN NOT EXISTS (SELECT 1 FROM records WHERE character = OLD.character) "
+					"BEGIN UPDATE generation SET value = value + 1; END"))
+	{
+		qWarning() << "Could not create the campaign tables" << setup.lastError().text();
+		return;
+	}
+
+	this->selectRecord = QSqlQuery(this->database);
+	this->selectRecord.prepare("SELECT data FROM records WHERE character = ? AND record = ?");
+	this->selectInfo = QSqlQuery(this->database);
+	this->selectInfo.prepare("SELECT length(data), modified FROM records WHERE character = ? AND record = ?");
+	this->upsertRecord = QSqlQuery(this->database);
+	this->upsertRecord.prepare("INSERT OR REPLACE INTO records (character, record, data, modified) VALUES (?, ?, ?, ?)");
+	this->appendRecord = QSqlQuery(this->database);
+	this->appendRecord.prepare("INSERT INTO records (character, record, data, modified) VALUES (?, ?, ?, ?) "
+							   "ON CONFLICT (character, record) DO UPDATE SET "
+							   "data = CAST(data || excluded.data AS BLOB), modified = excluded.modified");
+	this->open = true;
+}
+
+CampaignStore::~CampaignStore()
+{
+	// Every query has to be gone before the connection can be removed
+	this->selectRecord = QSqlQuery();
+	this->selectInfo = QSqlQuery();
+	this->upsertRecord = QSqlQuery();
+	this->appendRecord = QSqlQuery();
+	this->database.close();
+	this->database = QSqlDatabase();
+	QSqlDatabase::removeDatabase(this->connectionName);
+}
+
+QStringList CampaignStore::characters() const
+{
+	QStringList names;
+	if (!this->open)
+	{
+		return names;
+	}
+
+	// Answered from the primary key without reading any record data
+	QSqlQuery query("SELECT DISTINCT character FROM records ORDER BY character", this->database);
+	while (query.next())
+	{
+		names.append(query.value(0).toString());
+	}
+	return names;
+}
+
+QStringList CampaignStore::records(const QString &character) const
+{
+	QStringList names;
+	if (!this->open)
+	{
+		return names;
+	}
+
+	QSqlQuery query(this->database);
+	query.prepare("SELECT record FROM records WHERE character = ? ORDER BY record");
+	query.addBindValue(character);
+	query.exec();
+	while (query.next())
+	{
+		names.append(query.value(0).toString());
+	}
+	return names;
+}
+
+CharacterStorage::RecordInfo CampaignStore::info(const QString &character, const QString &record) const
+{
+	RecordInfo info;
+	if (!this->open)
+	{
+		return info;
+	}
+
+	this->selectInfo.addBindValue(character);
+	this->selectInfo.addBindValue(record);
+	if (this->selectInfo.exec() && this->selectInfo.next())
+	{
+		info.exists = true;
+		info.size = this->selectInfo.value(0).toLongLong();
+		info.lastModified = this->selectInfo.value(1).toLongLong();
+	}
+	this->selectInfo.finish();
+	return info;
+}
+
+qint64 CampaignStore::generation() const
+{
+	if (!this->open)
+	{
+		return 0;
+	}
+
+	QSqlQuery query("SELECT value FROM generation", this->database);
+	return query.next() ? query.value(0).toLongLong() : 0;
+}
+
+QByteArray CampaignStore::read(const QString &character, const QString &record, bool *ok) const
+{
+	QByteArray data;
+	bool found = false;
+	if (this->open)
+	{
+		this->selectRecord.addBindValue(character);
+		this->selectRecord.addBindValue(record);
+		if (this->selectRecord.exec() && this->selectRecord.next())
+		{
+			data = this->selectRecord.value(0).toByteArray();
+			found = true;
+		}
+		this->selectRecord.finish();
+	}
+	if (ok)
+	{
+		*ok = found;
+	}
+	return data;
+}
+
+bool CampaignStore::write(const QString &character, const QMap<QString, QByteArray> &records)
+{
+	if (!this->open || !this->database.transaction())
+	{
+		return false;
+	}
+
+	qint64 now = QDateTime::currentMSecsSinceEpoch();
+	for (auto it = records.constBegin(); it != records.constEnd(); ++it)
+	{
+		this->upsertRecord.addBindValue(character);
+		this->upsertRecord.addBindValue(it.key());
+		this->upsertRecord.addBindValue(it.value());
+		this->upsertRecord.addBindValue(now);
+		if (!this->upsertRecord.exec())
+		{
+			qWarning() << "Could not save" << it.key() << "for" << character << this->upsertRecord.lastError().text();
+			this->database.rollback();
+			return false;
+		}
+	}
+
+	if (!this->database.commit())
+	{
+		qWarning() << "Could not save" << character << this->database.lastError().text();
+		this->database.rollback();
+		return false;
+	}
+
+	// The folder is still where the portrait goes
+	QDir().mkpath(characterPath(character));
+	return true;
+}
+
+bool CampaignStore::append(const QString &character, const QString &record, const QByteArray &data)
+{
+	if (!this->open)
+	{
+		return false;
+	}
+
+	this->appendRecord.addBindValue(character);
+	this->appendRecord.addBindValue(record);
+	this->appendRecord.addBindValue(data);
+	this->appendRecord.addBindValue(QDateTime::currentMSecsSinceEpoch());
+	if (!this->appendRecord.exec())
+	{
+		qWarning() << "Could not add to" << record << "for" << character << this->appendRecord.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+bool CampaignStore::removeRecord(const QString &character, const QString &record)
+{
+	if (!this->open)
+	{
+		return false;
+	}
+
+	QSqlQuery query(this->database);
+	query.prepare("DELETE FROM records WHERE character = ? AND record = ?");
+	query.addBindValue(character);
+	query.addBindValue(record);
+	if (!query.exec())
+	{
+		qWarning() << "Could not remove" << record << "for" << character << query.lastError().text();
+		return false;
+	}
+	return true;
+}
+
+bool CampaignStore::removeCharacter(const QString &character)
+{
+	if (!this->open)
+	{
+		return false;
+	}
+
+	QSqlQuery query(this->database);
+	query.prepare("DELETE FROM records WHERE character = ?");
+	query.addBindValue(character);
+	if (!query.exec())
+	{
+		qWarning() << "Could not delete" << character << query.lastError().text();
+		return false;
+	}
+
+	QDir folder(characterPath(character));
+	return !folder.exists() || folder.removeRecursively();
+}
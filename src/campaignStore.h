@@ -0,0 +1,54 @@
+/*
+Name: campaignStore.h
+Description: Keeps every character's records in one SQLite campaign file, one row per record keyed by the
+			 character and record name, so listing, opening, and saving a character are indexed lookups and
+			 a save of several records is a single transaction.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CAMPAIGNSTORE_H
+#define CAMPAIGNSTORE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include "characterStorage.h"
+
+class CampaignStore : public CharacterStorage
+{
+public:
+	explicit CampaignStore(const QString &path);
+	~CampaignStore() override;
+
+	bool isOpen() const { return this->open; }
+
+	Backend backend() const override { return Campaign; }
+	QStringList characters() const override;
+	QStringList records(const QString &character) const override;
+	RecordInfo info(const QString &character, const QString &record) const override;
+	// A counter kept in the campaign file by triggers, the file's modified time does not move with the write ahead log
+	qint64 generation() const override;
+	QByteArray read(const QString &character, const QString &record, bool *ok = nullptr) const override;
+	bool write(const QString &character, const QMap<QString, QByteArray> &records) override;
+	bool append(const QString &character, const QString &record, const QByteArray &data) override;
+	bool removeRecord(const QString &character, const QString &record) override;
+	bool removeCharacter(const QString &character) override;
+
+	using CharacterStorage::write;
+
+private:
+	QString connectionName;
+	QSqlDatabase database;
+	bool open = false;
+
+	// Prepared once, they are run for every read and write
+	mutable QSqlQuery selectRecord;
+	mutable QSqlQuery selectInfo;
+	QSqlQuery upsertRecord;
+	QSqlQuery appendRecord;
+};
+
+#endif // CAMPAIGNSTORE_H
@@ -0,0 +1,76 @@
+/*
+Name: characterFile.cpp
+Description: The six records of a character's character.csv, kept in memory with a dirty flag for each so
+			 edits are collected and saved together in one atomic write instead of reading and rewriting
+			 the file for every change.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterFile.h"
+#include "characterStorage.h"
+
+#include <QDebug>
+
+CharacterFile::CharacterFile(const QString &character)
+	: character(character)
+{
+}
+
+bool CharacterFile::load()
+{
+	bool ok = false;
+	this->records = CharacterStorage::instance().readLines(this->character, "character.csv", &ok);
+	this->loaded = ok;
+	this->dirty = 0;
+
+	// Older files can be missing trailing records, they are written back out in full
+	while (this->records.size() < RecordCount)
+	{
+		this->records.append(QString());
+	}
+	return ok;
+}
+
+QStringList CharacterFile::list(Record record) const
+{
+	QStringList values;
+	const QStringList fields = this->record(record).split(",");
+	for (const QString &field : fields)
+	{
+		if (field != "" && field != " ")
+		{
+			values.append(field);
+		}
+	}
+	return values;
+}
+
+void CharacterFile::setRecord(Record record, const QString &value)
+{
+	if (!this->loaded || this->records[record] == value)
+	{
+		return;
+	}
+	this->records[record] = value;
+	this->dirty |= 1u << record;
+}
+
+bool CharacterFile::commit()
+{
+	if (!this->isDirty())
+	{
+		return true;
+	}
+
+	// The storage replaces the whole file at once, so a failed save leaves the last good copy
+	if (!CharacterStorage::instance().writeLines(this->character, "character.csv", this->records))
+	{
+		qWarning() << "Failed to save character file for" << this->character;
+		return false;
+	}
+	this->dirty = 0;
+	return true;
+}
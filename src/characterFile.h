@@ -0,0 +1,65 @@
+/*
+Name: characterFile.h
+Description: The six records of a character's character.csv, kept in memory with a dirty flag for each so
+			 edits are collected and saved together in one atomic write instead of reading and rewriting
+			 the file for every change.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERFILE_H
+#define CHARACTERFILE_H
+
+#include <QString>
+#include <QStringList>
+
+class CharacterFile
+{
+public:
+	/*
+		Character File Format:
+		1|    Name,Str,Dex,Con,Int,Wis,Cha,Level:Experience,MaxHealth:CurrentHealth:TempHealth,Class,Sub,Race,Subrace
+		2|    Skill Proficiencies (comma separated)
+		3|    Feats (comma separated)
+		4|    Languages (comma separated)
+		5|    Equipment Proficiencies (comma separated)
+		6|    Coins (platinum,gold,silver,copper)
+	*/
+	enum Record
+	{
+		Stats,
+		SkillProficiencies,
+		Feats,
+		Languages,
+		EquipmentProficiencies,
+		Coins,
+		RecordCount
+	};
+
+	explicit CharacterFile(const QString &character = QString());
+
+	// Reads the records from storage, dropping any changes that were not committed
+	bool load();
+	bool isLoaded() const { return this->loaded; }
+
+	QString record(Record record) const { return this->records.value(record); }
+	// The record split on commas, without empty values
+	QStringList list(Record record) const;
+	// Marks the record to be saved if it changed
+	void setRecord(Record record, const QString &value);
+	void setList(Record record, const QStringList &values) { this->setRecord(record, values.join(",")); }
+
+	bool isDirty() const { return this->dirty != 0; }
+	// Saves every record in a single write if any of them changed, returns false if the write failed
+	bool commit();
+
+private:
+	QString character;
+	QStringList records;
+	unsigned dirty = 0; // bit per record
+	bool loaded = false;
+};
+
+#endif // CHARACTERFILE_H
@@ -0,0 +1,51 @@
+/*
+Name: characterFilterModel.cpp
+Description: Filters the character select list down to the names matched by the search box.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterFilterModel.h"
+#include "characterListModel.h"
+
+CharacterFilterModel::CharacterFilterModel(QObject *parent)
+	: QSortFilterProxyModel(parent)
+{
+	// The source model is already in name order
+	this->setDynamicSortFilter(false);
+}
+
+void CharacterFilterModel::setMatches(const QSet<QString> &names)
+{
+	this->matches = names;
+	this->filtering = true;
+	this->invalidateFilter();
+}
+
+void CharacterFilterModel::clearMatches()
+{
+	if (!this->filtering)
+	{
+		return;
+	}
+	this->matches.clear();
+	this->filtering = false;
+	this->invalidateFilter();
+}
+
+bool CharacterFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+	if (!this->filtering)
+	{
+		return true;
+	}
+
+	// Asked of the list model directly, going through data() would start a thumbnail fetch for every row
+	const CharacterListModel *characters = qobject_cast<const CharacterListModel *>(this->sourceModel());
+	QString name = characters ? characters->characterName(sourceRow)
+							  : this->sourceModel()->index(sourceRow, 0, sourceParent).data(CharacterListModel::NameRole).toString();
+	// The "no characters" row has no name and is always shown
+	return name.isEmpty() || this->matches.contains(name);
+}
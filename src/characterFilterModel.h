@@ -0,0 +1,37 @@
+/*
+Name: characterFilterModel.h
+Description: Filters the character select list down to the names matched by the search box.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERFILTERMODEL_H
+#define CHARACTERFILTERMODEL_H
+
+#include <QSet>
+#include <QSortFilterProxyModel>
+#include <QString>
+
+class CharacterFilterModel : public QSortFilterProxyModel
+{
+	Q_OBJECT
+public:
+	explicit CharacterFilterModel(QObject *parent = nullptr);
+
+	// Shows only these characters
+	void setMatches(const QSet<QString> &names);
+	// Shows every character
+	void clearMatches();
+	bool isFiltering() const { return this->filtering; }
+
+protected:
+	bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+	QSet<QString> matches;
+	bool filtering = false;
+};
+
+#endif // CHARACTERFILTERMODEL_H
@@ -0,0 +1,290 @@
+/*
+Name: characterIndex.cpp
+Description: Persistent index of every character's summary at data/cache/characters.index so the select page
+			 reads one small file instead of every character's folder. Kept current by the app's own
+			 saves, by a QFileSystemWatcher on data/characters for characters added or removed outside of it,
+			 and by checking each character.csv's size and modified time at startup and when the app is focused.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterIndex.h"
+#include "characterStorage.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QSaveFile>
+#include <QSet>
+
+// Saves are held back this long so a burst of edits writes the index once
+static const int saveDelay = 500;
+
+static QDataStream &operator<<(QDataStream &out, const CharacterSummary &summary)
+{
+	out << summary.name << summary.characterClass << summary.subclass << summary.race << summary.subrace
+		<< qint32(summary.level) << qint32(summary.maxHitPoints) << summary.abilityScores << summary.lastModified
+		<< summary.fileSize << summary.valid;
+	return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, CharacterSummary &summary)
+{
+	qint32 level = 0;
+	qint32 maxHitPoints = 0;
+	in >> summary.name >> summary.characterClass >> summary.subclass >> summary.race >> summary.subrace >> level
+		>> maxHitPoints >> summary.abilityScores >> summary.lastModified >> summary.fileSize >> summary.valid;
+	summary.level = level;
+	summary.maxHitPoints = maxHitPoints;
+	return in;
+}
+
+CharacterIndex &CharacterIndex::instance()
+{
+	static CharacterIndex index;
+	return index;
+}
+
+CharacterIndex::CharacterIndex()
+{
+	this->saveTimer.setSingleShot(true);
+	this->saveTimer.setInterval(saveDelay);
+	connect(&this->saveTimer, &QTimer::timeout, this, &CharacterIndex::save);
+	if (qApp)
+	{
+		connect(qApp, &QCoreApplication::aboutToQuit, this, &CharacterIndex::flush);
+	}
+
+	bool loaded = this->load();
+	if (!loaded)
+	{
+		this->rebuild();
+	}
+
+	// Only the characters folder is watched, one watch per character.csv runs into the system's
+	// limit on watches with enough characters. It changes when a character's folder is added or removed
+	QDir().mkpath(charactersPath());
+	this->watcher.addPath(charactersPath());
+	connect(&this->watcher, &QFileSystemWatcher::directoryChanged, this, &CharacterIndex::reconcile);
+
+	// The characters on disk are only listed again if one was added or removed since the index was written,
+	// otherwise each character.csv is checked for edits made outside of the app. Either waits until the
+	// event loop is running so startup is not held up by it
+	if (loaded)
+	{
+		QTimer::singleShot(0, this, [this]() {
+			if (this->stamp != CharacterStorage::instance().generation())
+			{
+				this->reconcile();
+			}
+			else
+			{
+				this->refresh();
+			}
+		});
+	}
+
+	// Coming back to the app is when a character.csv edited elsewhere is most likely
+	if (qGuiApp)
+	{
+		connect(qGuiApp, &QGuiApplication::applicationStateChanged, this, [this](Qt::ApplicationState state) {
+			if (state == Qt::ApplicationActive)
+			{
+				this->refresh();
+			}
+		});
+	}
+}
+
+CharacterIndex::~CharacterIndex()
+{
+	this->flush();
+}
+
+QString CharacterIndex::charactersPath()
+{
+	return QDir::currentPath() + "/data/characters";
+}
+
+QString CharacterIndex::indexPath()
+{
+	return QDir::currentPath() + "/data/cache/characters.index";
+}
+
+
+void CharacterIndex::update(const QString &name)
+{
+	bool added = !this->entries.contains(name);
+	if (!added)
+	{
+		// Only the file's details are looked at here, it is read again only if they changed
+		CharacterStorage::RecordInfo info = CharacterStorage::instance().info(name, "character.csv");
+		const CharacterSummary &current = this->entries[name];
+		if (current.lastModified == info.lastModified && current.fileSize == info.size)
+		{
+			return;
+		}
+	}
+
+	this->entries.insert(name, CharacterSummary::read(name));
+	this->scheduleSave();
+	if (added)
+	{
+		emit characterAdded(name);
+	}
+	else
+	{
+		emit characterChanged(name);
+	}
+}
+
+void CharacterIndex::remove(const QString &name)
+{
+	if (!this->entries.remove(name))
+	{
+		return;
+	}
+	this->scheduleSave();
+	emit characterRemoved(name);
+}
+
+void CharacterIndex::flush()
+{
+	if (this->saveTimer.isActive())
+	{
+		this->saveTimer.stop();
+		this->save();
+	}
+}
+
+bool CharacterIndex::load()
+{
+	QFile file(indexPath());
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	QDataStream in(&file);
+	quint32 fileMagic = 0;
+	quint32 fileVersion = 0;
+	quint32 count = 0;
+	in >> fileMagic >> fileVersion;
+	if (fileMagic != magic || fileVersion != version)
+	{
+		qDebug() << "Character index is from a different version, rebuilding it";
+		return false;
+	}
+	qint64 fileStamp = 0;
+	in >> fileStamp >> count;
+
+	QMap<QString, CharacterSummary> loaded;
+	for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++)
+	{
+		CharacterSummary summary;
+		in >> summary;
+		loaded.insert(summary.name, summary);
+	}
+	if (in.status() != QDataStream::Ok)
+	{
+		qWarning() << "Character index is corrupt, rebuilding it";
+		return false;
+	}
+
+	this->entries = loaded;
+	this->stamp = fileStamp;
+	return true;
+}
+
+void CharacterIndex::rebuild()
+{
+	// Taken before the characters are listed, so anything added while listing them is caught next time
+	this->stamp = CharacterStorage::instance().generation();
+	this->entries.clear();
+	const QStringList names = CharacterStorage::instance().characters();
+	for (const QString &name : names)
+	{
+		this->entries.insert(name, CharacterSummary::read(name));
+	}
+	this->save();
+	// The first version of the index was kept among the character folders
+	QFile::remove(charactersPath() + "/.index");
+}
+
+void CharacterIndex::save()
+{
+	QDir().mkpath(QFileInfo(indexPath()).absolutePath());
+	QSaveFile file(indexPath());
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "Could not write the character index:" << file.errorString();
+		return;
+	}
+
+	QDataStream out(&file);
+	out << magic << version << this->stamp << quint32(this->entries.size());
+	for (const CharacterSummary &summary : this->entries)
+	{
+		out << summary;
+	}
+	if (!file.commit())
+	{
+		qWarning() << "Could not write the character index:" << file.errorString();
+	}
+}
+
+/**
+ * This function brings the index in line with the character storage, adding and removing
+ * characters and re-reading any whose character.csv changed since it was indexed
+ */
+void CharacterIndex::reconcile()
+{
+	qint64 current = CharacterStorage::instance().generation();
+	if (current != this->stamp)
+	{
+		this->stamp = current;
+		this->scheduleSave();
+	}
+
+	const QStringList stored = CharacterStorage::instance().characters();
+	QSet<QString> present;
+	for (const QString &name : stored)
+	{
+		present.insert(name);
+	}
+
+	for (const QString &name : this->entries.keys())
+	{
+		if (!present.contains(name))
+		{
+			this->remove(name);
+		}
+	}
+	for (const QString &name : stored)
+	{
+		this->update(name);
+	}
+}
+
+/**
+ * This function re-reads any indexed character whose character.csv changed, only its size and modified time
+ * are looked at for the rest
+ */
+void CharacterIndex::refresh()
+{
+	for (const QString &name : this->entries.keys())
+	{
+		this->update(name);
+	}
+}
+
+void CharacterIndex::scheduleSave()
+{
+	this->saveTimer.start();
+}
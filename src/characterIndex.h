@@ -0,0 +1,71 @@
+/*
+Name: characterIndex.h
+Description: Persistent index of every character's summary at data/cache/characters.index so the select page
+			 reads one small file instead of every character's folder. Kept current by the app's own
+			 saves, by a QFileSystemWatcher on data/characters for characters added or removed outside of it,
+			 and by checking each character.csv's size and modified time at startup and when the app is focused.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERINDEX_H
+#define CHARACTERINDEX_H
+
+#include <QFileSystemWatcher>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+#include "characterSummary.h"
+
+class CharacterIndex : public QObject
+{
+	Q_OBJECT
+public:
+	// Returns the shared index, loading it (or building it if it is missing) on the first call
+	static CharacterIndex &instance();
+
+	QStringList names() const { return this->entries.keys(); }
+	QList<CharacterSummary> summaries() const { return this->entries.values(); }
+	bool contains(const QString &name) const { return this->entries.contains(name); }
+	CharacterSummary summary(const QString &name) const { return this->entries.value(name); }
+
+	// Re-reads a character's summary if character.csv changed, call after writing to it
+	void update(const QString &name);
+	// Removes a character, call after deleting their folder
+	void remove(const QString &name);
+	// Writes any pending changes to disk now instead of waiting for the save timer
+	void flush();
+
+	static constexpr quint32 magic = 0x49444E44; // "DNDI"
+	static constexpr quint32 version = 2;
+
+signals:
+	void characterAdded(const QString &name);
+	void characterChanged(const QString &name);
+	void characterRemoved(const QString &name);
+
+private:
+	CharacterIndex();
+	~CharacterIndex();
+
+	static QString charactersPath();
+	static QString indexPath();
+	bool load();
+	void rebuild();
+	void save();
+	void reconcile();
+	void refresh();
+	void scheduleSave();
+
+	QMap<QString, CharacterSummary> entries;
+	qint64 stamp = 0; // storage generation when the index was last in line with it
+	QFileSystemWatcher watcher;
+	QTimer saveTimer;
+};
+
+#endif // CHARACTERINDEX_H
@@ -0,0 +1,294 @@
+/*
+Name: characterListModel.cpp
+Description: List model for the character select page. Rows are filled from the character index, and the
+			 thumbnails are fetched in the background for the rows a view asks about.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterListModel.h"
+#include "thumbnailCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+// Most thumbnails read by one background fetch, so the first visible rows fill in quickly
+static const int fetchBatchSize = 32;
+static const QStringList imageExtentions = {"png", "jpg", "bmp", "jpeg"};
+
+CharacterListModel::CharacterListModel(QObject *parent)
+	: QAbstractListModel(parent), fetchTimer(new QTimer(this)), watcher(new QFutureWatcher<QList<FetchResult>>(this))
+{
+	// Collect every row the view asks about during one paint before starting a fetch
+	this->fetchTimer->setSingleShot(true);
+	this->fetchTimer->setInterval(0);
+	connect(this->fetchTimer, &QTimer::timeout, this, &CharacterListModel::startFetch);
+	connect(this->watcher, &QFutureWatcher<QList<FetchResult>>::finished, this, &CharacterListModel::finishFetch);
+}
+
+void CharacterListModel::setCharacters(const QList<CharacterSummary> &summaries)
+{
+	beginResetModel();
+	this->rows.clear();
+	this->rowByName.clear();
+	this->fetchQueue.clear();
+	this->requested.clear();
+
+	this->rows.reserve(summaries.size());
+	for (const CharacterSummary &summary : summaries)
+	{
+		this->rowByName.insert(summary.name, this->rows.size());
+		this->rows.append(Row{summary.name, summary, QPixmap(), false});
+	}
+	endResetModel();
+}
+
+void CharacterListModel::updateCharacter(const CharacterSummary &summary)
+{
+	int row = this->rowByName.value(summary.name, -1);
+	if (row >= 0)
+	{
+		// The portrait may have changed along with the sheet, so it is read again too
+		this->rows[row].summary = summary;
+		this->refreshCharacter(summary.name);
+		return;
+	}
+
+	row = 0;
+	while (row < this->rows.size() && this->rows[row].name < summary.name)
+	{
+		row++;
+	}
+
+	// Going from no characters to one swaps out the placeholder row
+	bool firstRow = this->rows.isEmpty();
+	if (firstRow)
+	{
+		beginResetModel();
+	}
+	else
+	{
+		beginInsertRows(QModelIndex(), row, row);
+	}
+
+	this->rows.insert(row, Row{summary.name, summary, QPixmap(), false});
+	for (int i = row; i < this->rows.size(); i++)
+	{
+		this->rowByName[this->rows[i].name] = i;
+	}
+
+	if (firstRow)
+	{
+		endResetModel();
+	}
+	else
+	{
+		endInsertRows();
+	}
+}
+
+void CharacterListModel::removeCharacter(const QString &name)
+{
+	int row = this->rowByName.value(name, -1);
+	if (row < 0)
+	{
+		return;
+	}
+
+	// Going from one character to none swaps in the placeholder row
+	bool lastRow = this->rows.size() == 1;
+	if (lastRow)
+	{
+		beginResetModel();
+	}
+	else
+	{
+		beginRemoveRows(QModelIndex(), row, row);
+	}
+
+	this->rows.remove(row);
+	this->rowByName.remove(name);
+	for (int i = row; i < this->rows.size(); i++)
+	{
+		this->rowByName[this->rows[i].name] = i;
+	}
+	this->fetchQueue.removeAll(name);
+	this->requested.remove(name);
+
+	if (lastRow)
+	{
+		endResetModel();
+	}
+	else
+	{
+		endRemoveRows();
+	}
+}
+
+void CharacterListModel::refreshCharacter(const QString &name)
+{
+	int row = this->rowByName.value(name, -1);
+	if (row < 0)
+	{
+		return;
+	}
+
+	this->rows[row].fetched = false;
+	this->requested.remove(name);
+	emit dataChanged(index(row), index(row));
+}
+
+QString CharacterListModel::characterName(const QModelIndex &index) const
+{
+	return index.isValid() ? index.data(NameRole).toString() : QString();
+}
+
+QString CharacterListModel::characterName(int row) const
+{
+	return row >= 0 && row < this->rows.size() ? this->rows.at(row).name : QString();
+}
+
+int CharacterListModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return this->rows.isEmpty() ? 1 : this->rows.size(); // the placeholder row when there are no characters
+}
+
+Qt::ItemFlags CharacterListModel::flags(const QModelIndex &index) const
+{
+	if (this->rows.isEmpty())
+	{
+		return Qt::NoItemFlags; // the placeholder row can not be selected or opened
+	}
+	return QAbstractListModel::flags(index);
+}
+
+QVariant CharacterListModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid())
+	{
+		return QVariant();
+	}
+
+	if (this->rows.isEmpty())
+	{
+		return role == Qt::DisplayRole ? QVariant(QString("No Characters Have been created")) : QVariant();
+	}
+
+	const Row &row = this->rows.at(index.row());
+
+	// Views only ask about rows they are drawing, so that is when the thumbnail is fetched
+	if (!row.fetched)
+	{
+		this->requestFetch(row.name);
+	}
+
+	switch (role)
+	{
+	case Qt::DisplayRole:
+		return row.summary.valid ? row.name + "\n" + row.summary.description() : row.name;
+	case Qt::DecorationRole:
+	{
+		if (!row.thumbnail.isNull())
+		{
+			return row.thumbnail;
+		}
+		// Blank space the size of a thumbnail keeps every row the same height
+		static QPixmap blank;
+		if (blank.isNull())
+		{
+			blank = QPixmap(thumbnailSize());
+			blank.fill(Qt::transparent);
+		}
+		return blank;
+	}
+	case NameRole:
+		return row.name;
+	case SummaryRole:
+		return row.summary.description();
+	}
+	return QVariant();
+}
+
+void CharacterListModel::requestFetch(const QString &name) const
+{
+	if (this->requested.contains(name))
+	{
+		return;
+	}
+	this->requested.insert(name);
+	this->fetchQueue.append(name);
+
+	if (!this->watcher->isRunning())
+	{
+		this->fetchTimer->start();
+	}
+}
+
+void CharacterListModel::startFetch()
+{
+	if (this->fetchQueue.isEmpty() || this->watcher->isRunning())
+	{
+		return;
+	}
+
+	// Newest requests are the rows on screen right now, so they go first
+	QStringList batch;
+	while (!this->fetchQueue.isEmpty() && batch.size() < fetchBatchSize)
+	{
+		batch.append(this->fetchQueue.takeLast());
+	}
+
+	this->watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), &CharacterListModel::fetch, batch));
+}
+
+void CharacterListModel::finishFetch()
+{
+	const QList<FetchResult> results = this->watcher->result();
+	for (const FetchResult &result : results)
+	{
+		// The character may have been removed while it was being read
+		int row = this->rowByName.value(result.name, -1);
+		if (row < 0 || !this->requested.contains(result.name))
+		{
+			continue;
+		}
+
+		this->rows[row].thumbnail = QPixmap::fromImage(result.thumbnail);
+		this->rows[row].fetched = true;
+		emit dataChanged(index(row), index(row));
+	}
+
+	this->startFetch();
+}
+
+/**
+ * This function reads the thumbnails of a batch of characters, it runs on the thread pool
+ */
+QList<CharacterListModel::FetchResult> CharacterListModel::fetch(const QStringList &names)
+{
+	QList<FetchResult> results;
+	for (const QString &name : names)
+	{
+		FetchResult result{name, QImage()};
+
+		QString imageDir = QDir::currentPath() + "/data/characters/" + name + "/";
+		for (const QString &ext : imageExtentions)
+		{
+			if (QFile::exists(imageDir + "character." + ext))
+			{
+				result.thumbnail = ThumbnailCache::image(imageDir + "character." + ext, thumbnailSize(), true);
+				break;
+			}
+		}
+		results.append(result);
+	}
+	return results;
+}
@@ -0,0 +1,86 @@
+/*
+Name: characterListModel.h
+Description: List model for the character select page. Rows are filled from the character index, and the
+			 thumbnails are fetched in the background for the rows a view asks about.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERLISTMODEL_H
+#define CHARACTERLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include "characterSummary.h"
+
+class CharacterListModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	enum Roles
+	{
+		NameRole = Qt::UserRole, // the character's name, empty for the "no characters" row
+		SummaryRole				 // ex. "Level 9 Human Wizard"
+	};
+
+	explicit CharacterListModel(QObject *parent = nullptr);
+
+	// Summaries are expected in name order, as the character index gives them
+	void setCharacters(const QList<CharacterSummary> &summaries);
+	// Adds the character in name order, or replaces their summary if they are already listed
+	void updateCharacter(const CharacterSummary &summary);
+	void removeCharacter(const QString &name);
+	// Drops the fetched thumbnail for a character so it is read again the next time it is shown
+	void refreshCharacter(const QString &name);
+	QString characterName(const QModelIndex &index) const;
+	// Name of the character in a row of this model, empty for the "no characters" row
+	QString characterName(int row) const;
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+	static QSize thumbnailSize() { return QSize(40, 60); }
+
+private:
+	struct Row
+	{
+		QString name;
+		CharacterSummary summary;
+		QPixmap thumbnail;
+		bool fetched = false; // whether the thumbnail has been read, the summary comes from the index
+	};
+
+	struct FetchResult
+	{
+		QString name;
+		QImage thumbnail;
+	};
+
+	void requestFetch(const QString &name) const;
+	void startFetch();
+	void finishFetch();
+	static QList<FetchResult> fetch(const QStringList &names);
+
+	QVector<Row> rows;
+	QHash<QString, int> rowByName;
+
+	// Names the view has asked about that have not been fetched yet, newest last
+	mutable QStringList fetchQueue;
+	mutable QSet<QString> requested;
+	QTimer *fetchTimer;
+	QFutureWatcher<QList<FetchResult>> *watcher;
+};
+
+#endif // CHARACTERLISTMODEL_H
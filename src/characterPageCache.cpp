@@ -0,0 +1,185 @@
+/*
+Name: characterPageCache.cpp
+Description: Bounded LRU cache of the built page sets (sheet, inventory, spells, notes) of recently
+			 opened characters, so switching back to one is a widget swap instead of a rebuild.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterPageCache.h"
+#include "characterStorage.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+
+// The portrait is shown scaled to 200x300 with 4 bytes per pixel no matter the file size
+static const qint64 portraitBytes = 200 * 300 * 4;
+static const QStringList imageExtentions = {"png", "jpg", "bmp", "jpeg"};
+
+static QString characterPath(const QString &name)
+{
+	return CharacterStorage::characterPath(name);
+}
+
+CharacterPageCache::CharacterPageCache(int capacity, qint64 memoryBudget)
+	: capacity(capacity), memoryBudget(memoryBudget)
+{
+}
+
+CharacterPageCache::~CharacterPageCache()
+{
+	for (Entry &entry : this->entries)
+	{
+		release(entry);
+	}
+}
+
+void CharacterPageCache::setCapacity(int capacity)
+{
+	this->capacity = capacity;
+	this->evict();
+}
+
+void CharacterPageCache::setMemoryBudget(qint64 memoryBudget)
+{
+	this->memoryBudget = memoryBudget;
+	this->evict();
+}
+
+void CharacterPageCache::store(const QString &name, const QList<QWidget *> &pages)
+{
+	this->invalidate(name);
+
+	// Detach the pages so they can not reach into whatever stack they were taken from
+	for (QWidget *page : pages)
+	{
+		page->setParent(nullptr);
+	}
+
+	Entry entry{pages, fingerprint(name), estimateCost(name)};
+	this->entries.insert(name, entry);
+	this->recentlyUsed.prepend(name);
+	this->totalCost += entry.cost;
+
+	this->evict();
+}
+
+QList<QWidget *> CharacterPageCache::take(const QString &name)
+{
+	auto it = this->entries.find(name);
+	if (it == this->entries.end())
+	{
+		return {};
+	}
+
+	// Something other than these pages wrote to the character, so they are out of date
+	if (it.value().fingerprint != fingerprint(name))
+	{
+		this->invalidate(name);
+		return {};
+	}
+
+	QList<QWidget *> pages = it.value().pages;
+	this->totalCost -= it.value().cost;
+	this->entries.erase(it);
+	this->recentlyUsed.removeOne(name);
+	return pages;
+}
+
+void CharacterPageCache::invalidate(const QString &name)
+{
+	auto it = this->entries.find(name);
+	if (it == this->entries.end())
+	{
+		return;
+	}
+
+	this->totalCost -= it.value().cost;
+	release(it.value());
+	this->entries.erase(it);
+	this->recentlyUsed.removeOne(name);
+}
+
+/**
+ * This function removes the least recently used characters until the cache fits its limits
+ */
+void CharacterPageCache::evict()
+{
+	while (!this->recentlyUsed.isEmpty() &&
+		   (this->recentlyUsed.size() > this->capacity || this->totalCost > this->memoryBudget))
+	{
+		this->invalidate(this->recentlyUsed.last());
+	}
+}
+
+void CharacterPageCache::release(Entry &entry)
+{
+	for (QWidget *page : entry.pages)
+	{
+		page->deleteLater();
+	}
+	entry.pages.clear();
+}
+
+/**
+ * This function describes every file of a character by path, size, and modification time
+ */
+QString CharacterPageCache::fingerprint(const QString &name)
+{
+	QString path = characterPath(name);
+	QStringList files;
+
+	QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext())
+	{
+		it.next();
+		QFileInfo info = it.fileInfo();
+		files.append(info.filePath().mid(path.size()) + "|" + QString::number(info.size()) + "|" +
+					 QString::number(info.lastModified().toMSecsSinceEpoch()));
+	}
+
+	// Records kept in the campaign file are not in the folder
+	CharacterStorage &storage = CharacterStorage::instance();
+	if (storage.backend() == CharacterStorage::Campaign)
+	{
+		for (const QString &record : storage.records(name))
+		{
+			CharacterStorage::RecordInfo info = storage.info(name, record);
+			files.append(record + "|" + QString::number(info.size) + "|" + QString::number(info.lastModified));
+		}
+	}
+
+	files.sort();
+	return files.join("\n");
+}
+
+/**
+ * This function estimates the memory a character's pages hold from the size of its files
+ */
+qint64 CharacterPageCache::estimateCost(const QString &name)
+{
+	qint64 cost = 0;
+
+	QDirIterator it(characterPath(name), QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext())
+	{
+		it.next();
+		QFileInfo info = it.fileInfo();
+		cost += imageExtentions.contains(info.suffix().toLower()) ? portraitBytes : info.size();
+	}
+
+	CharacterStorage &storage = CharacterStorage::instance();
+	if (storage.backend() == CharacterStorage::Campaign)
+	{
+		for (const QString &record : storage.records(name))
+		{
+			cost += storage.info(name, record).size;
+		}
+	}
+
+	return cost;
+}
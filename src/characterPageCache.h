@@ -0,0 +1,58 @@
+/*
+Name: characterPageCache.h
+Description: Bounded LRU cache of the built page sets (sheet, inventory, spells, notes) of recently
+			 opened characters, so switching back to one is a widget swap instead of a rebuild.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERPAGECACHE_H
+#define CHARACTERPAGECACHE_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QWidget>
+
+class CharacterPageCache
+{
+public:
+	// capacity is the most characters kept, memoryBudget the most estimated bytes kept
+	explicit CharacterPageCache(int capacity = 6, qint64 memoryBudget = 64 * 1024 * 1024);
+	~CharacterPageCache();
+
+	void setCapacity(int capacity);
+	void setMemoryBudget(qint64 memoryBudget);
+
+	// Takes ownership of a character's pages, evicting the least recently used entries if needed
+	void store(const QString &name, const QList<QWidget *> &pages);
+	// Hands back the pages of a character, or an empty list if they were never cached,
+	// were evicted, or the character's files changed since they were stored
+	QList<QWidget *> take(const QString &name);
+	// Drops a character's pages, ex. when the character is deleted
+	void invalidate(const QString &name);
+
+private:
+	struct Entry
+	{
+		QList<QWidget *> pages;
+		QString fingerprint;
+		qint64 cost;
+	};
+
+	static QString fingerprint(const QString &name);
+	static qint64 estimateCost(const QString &name);
+	static void release(Entry &entry);
+	void evict();
+
+	int capacity;
+	qint64 memoryBudget;
+	qint64 totalCost = 0;
+	QMap<QString, Entry> entries;
+	QStringList recentlyUsed; // most recently used first
+};
+
+#endif // CHARACTERPAGECACHE_H
@@ -0,0 +1,237 @@
+/*
+Name: characterSearchIndex.cpp
+Description: In memory word prefix and trigram index over the character summaries, used to filter the
+			 character select list as the user types without reading any character files.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterSearchIndex.h"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <climits>
+
+void CharacterSearchIndex::clear()
+{
+	this->entries.clear();
+	this->wordIndex.clear();
+	this->trigramIndex.clear();
+}
+
+void CharacterSearchIndex::setCharacters(const QList<CharacterSummary> &summaries)
+{
+	this->clear();
+	this->entries.reserve(summaries.size());
+	for (const CharacterSummary &summary : summaries)
+	{
+		this->insert(summary);
+	}
+}
+
+void CharacterSearchIndex::insert(const CharacterSummary &summary)
+{
+	this->remove(summary.name);
+
+	Entry entry;
+	entry.text = QStringList({summary.name, summary.characterClass, summary.subclass, summary.race, summary.subrace})
+					 .join(" ")
+					 .toLower();
+	static const QRegularExpression wordSeparator("[^\\w]+");
+	entry.words = entry.text.split(wordSeparator, Qt::SkipEmptyParts);
+	entry.level = summary.level;
+
+	for (const QString &word : entry.words)
+	{
+		this->wordIndex[word].insert(summary.name);
+	}
+	for (const QString &trigram : trigrams(entry.text))
+	{
+		this->trigramIndex[trigram].insert(summary.name);
+	}
+	this->entries.insert(summary.name, entry);
+}
+
+void CharacterSearchIndex::remove(const QString &name)
+{
+	auto it = this->entries.find(name);
+	if (it == this->entries.end())
+	{
+		return;
+	}
+
+	for (const QString &word : it->words)
+	{
+		auto posting = this->wordIndex.find(word);
+		if (posting != this->wordIndex.end() && posting->remove(name) && posting->isEmpty())
+		{
+			this->wordIndex.erase(posting);
+		}
+	}
+	for (const QString &trigram : trigrams(it->text))
+	{
+		auto posting = this->trigramIndex.find(trigram);
+		if (posting != this->trigramIndex.end() && posting->remove(name) && posting->isEmpty())
+		{
+			this->trigramIndex.erase(posting);
+		}
+	}
+	this->entries.erase(it);
+}
+
+QSet<QString> CharacterSearchIndex::search(const QString &query) const
+{
+	static const QRegularExpression termSeparator("\\s+");
+	const QStringList terms = query.toLower().split(termSeparator, Qt::SkipEmptyParts);
+
+	int minLevel = 0;
+	int maxLevel = INT_MAX;
+	bool first = true;
+	QSet<QString> matches;
+	for (const QString &term : terms)
+	{
+		int termMin = 0;
+		int termMax = 0;
+		if (parseLevelRange(term, termMin, termMax))
+		{
+			minLevel = qMax(minLevel, termMin);
+			maxLevel = qMin(maxLevel, termMax);
+			continue;
+		}
+
+		QSet<QString> termMatches = this->matchTerm(term);
+		if (first)
+		{
+			matches = termMatches;
+			first = false;
+		}
+		else
+		{
+			matches.intersect(termMatches);
+		}
+		if (matches.isEmpty())
+		{
+			return matches;
+		}
+	}
+
+	// Only level terms, so every character is a candidate
+	if (first)
+	{
+		for (auto it = this->entries.constBegin(); it != this->entries.constEnd(); ++it)
+		{
+			matches.insert(it.key());
+		}
+	}
+
+	if (minLevel > 0 || maxLevel < INT_MAX)
+	{
+		for (auto it = matches.begin(); it != matches.end();)
+		{
+			int level = this->entries.value(*it).level;
+			if (level < minLevel || level > maxLevel)
+			{
+				it = matches.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+	return matches;
+}
+
+/**
+ * This function reads a level term, "5", "3-7", "10+", optionally after "level:" or "lvl:"
+ */
+bool CharacterSearchIndex::parseLevelRange(const QString &term, int &minLevel, int &maxLevel)
+{
+	static const QRegularExpression levelTerm("^(?:level|lvl)?[:=]?(\\d+)(?:(\\+)|-(\\d+))?$");
+	QRegularExpressionMatch match = levelTerm.match(term);
+	if (!match.hasMatch())
+	{
+		return false;
+	}
+
+	minLevel = match.captured(1).toInt();
+	if (!match.captured(2).isEmpty())
+	{
+		maxLevel = INT_MAX;
+	}
+	else if (!match.captured(3).isEmpty())
+	{
+		maxLevel = match.captured(3).toInt();
+	}
+	else
+	{
+		maxLevel = minLevel;
+	}
+	if (minLevel > maxLevel)
+	{
+		qSwap(minLevel, maxLevel);
+	}
+	return true;
+}
+
+QSet<QString> CharacterSearchIndex::trigrams(const QString &text)
+{
+	QSet<QString> result;
+	for (int i = 0; i + 3 <= text.size(); i++)
+	{
+		result.insert(text.mid(i, 3));
+	}
+	return result;
+}
+
+QSet<QString> CharacterSearchIndex::matchTerm(const QString &term) const
+{
+	QSet<QString> matches;
+
+	// Every word starting with the term sits in one ordered range of the word index
+	for (auto it = this->wordIndex.lowerBound(term); it != this->wordIndex.constEnd() && it.key().startsWith(term); ++it)
+	{
+		matches.unite(it.value());
+	}
+
+	if (term.size() < 3)
+	{
+		return matches;
+	}
+
+	// Characters holding every trigram of the term are checked for the term itself, starting from the rarest
+	QList<const QSet<QString> *> postings;
+	for (const QString &trigram : trigrams(term))
+	{
+		auto posting = this->trigramIndex.constFind(trigram);
+		if (posting == this->trigramIndex.constEnd())
+		{
+			return matches;
+		}
+		postings.append(&posting.value());
+	}
+	std::sort(postings.begin(), postings.end(), [](const QSet<QString> *a, const QSet<QString> *b) {
+		return a->size() < b->size();
+	});
+
+	for (const QString &name : *postings.first())
+	{
+		if (matches.contains(name))
+		{
+			continue;
+		}
+		bool candidate = true;
+		for (int i = 1; i < postings.size() && candidate; i++)
+		{
+			candidate = postings[i]->contains(name);
+		}
+		if (candidate && this->entries.value(name).text.contains(term))
+		{
+			matches.insert(name);
+		}
+	}
+	return matches;
+}
@@ -0,0 +1,56 @@
+/*
+Name: characterSearchIndex.h
+Description: In memory word prefix and trigram index over the character summaries, used to filter the
+			 character select list as the user types without reading any character files.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERSEARCHINDEX_H
+#define CHARACTERSEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include "characterSummary.h"
+
+class CharacterSearchIndex
+{
+public:
+	void clear();
+	void setCharacters(const QList<CharacterSummary> &summaries);
+	// Adds a character, or re-indexes them if they are already indexed
+	void insert(const CharacterSummary &summary);
+	void remove(const QString &name);
+
+	/*
+	 * Returns the names of the characters matching every term of the query. A term matches the start of a
+	 * word in the name, class, subclass, race or subrace, or anywhere in them if it is 3 or more letters.
+	 * Terms that are levels filter by level instead, ex. "5", "3-7", "10+", "level:5", "lvl:3-7"
+	 */
+	QSet<QString> search(const QString &query) const;
+
+private:
+	struct Entry
+	{
+		QString text; // lower case name, class, subclass, race and subrace separated by spaces
+		QStringList words;
+		int level = 0;
+	};
+
+	static bool parseLevelRange(const QString &term, int &minLevel, int &maxLevel);
+	static QSet<QString> trigrams(const QString &text);
+	QSet<QString> matchTerm(const QString &term) const;
+
+	QHash<QString, Entry> entries;
+	QMap<QString, QSet<QString>> wordIndex;	  // word -> names, ordered so a prefix is a contiguous range
+	QHash<QString, QSet<QString>> trigramIndex; // three letters -> names whose text contains them
+};
+
+#endif // CHARACTERSEARCHINDEX_H
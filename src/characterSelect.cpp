@@ -1,19 +1,21 @@
 /*
 Name: characterSelect.cpp
 Description: Main landing page for the application, allowing users to create, delete, and manage characters.
-			 Also provides navigation to settings.
+			 Also provides navigation to settings and the notes search.
 Authors: Carson Treece, Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 10/22/2024
-Last Modified: 11/24/2024
+Last Modified: 10/17/2026
 */
 
 #include "addCharacter.h"
 #include "characterSelect.h"
-#include "viewCharacter.h"
-#include "viewInventory.h"
-#include "viewSpells.h"
+#include "characterIndex.h"
+#include "characterStorage.h"
+#include "notesStore.h"
+#include "notesSearchIndex.h"
 #include "viewNotes.h"
+#include "viewCharacter.h"
 #include "themeUtils.h"
 
 #include <iostream>
@@ -23,13 +25,21 @@ Last Modified: 11/24/2024
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QPushButton>
-#include <QListWidget>
+#include <QListView>
 #include <QWidget>
 #include <QLayout>
 #include <QDialog>
 #include <QLabel>
 #include <QFile>
 #include <QDir>
+#include <QTimer>
+
+// How long after a character sheet is shown to start building its other pages, in ms
+static const int prewarmDelay = 500;
+
+// Limits for the cache of recently viewed characters' pages
+static const int cachedCharacters = 6;
+static const qint64 cachedCharacterBytes = 64 * 1024 * 1024;
 
 // Add a new character to the list
 // deprecated/not used
@@ -62,19 +72,11 @@ void CharacterSelect::addCharacter(QString charName)
 			// Create the character directory
 			if (dir.mkpath(charPath))
 			{
-				// Create the notes and databases files inside the folder
-				QFile notesFile(charPath + "/notes.json"); // Create a notes file
-				if (notesFile.open(QIODevice::WriteOnly | QIODevice::Text))
-				{
-					QTextStream out(&notesFile);
-					out << "Character Notes"; // Add default content to notes.txt
-					notesFile.close();		  // Close the file
-				}
+				// Create the notes index for the character
+				CharacterStorage::instance().write(charName, "notes.index", NotesStore::emptyIndex());
 
 				// Add character to the list
-				std::cout << "before addItem(charName);, charName = " << charName.toStdString() << std::endl;
-				this->characters->addItem(charName);
-				std::cout << "after addItem(charName);" << std::endl;
+				this->loadCharacterList();
 			}
 			else
 			{
@@ -88,11 +90,9 @@ void CharacterSelect::addCharacter(QString charName)
 // Delete the selected character
 void CharacterSelect::deleteCharacter()
 {
-	QListWidgetItem *item = this->characters->currentItem();
-	if (item != nullptr)
+	QString name = this->characterModel->characterName(this->characters->currentIndex());
+	if (!name.isEmpty())
 	{
-		// gets the name of the character
-		QString name = item->text();
 
 		// creates popup for the user to confirm the deletion of their character
 		QDialog popup;
@@ -143,18 +143,27 @@ void CharacterSelect::deleteCharacter()
 		// if the user confirms the deletion
 		if (popup.result() == QDialog::Accepted)
 		{
-			// removes the character from the list
-			// this->characters->removeItemWidget(item);
+			QString charName = name; // Get the name of the character
 
-			QString charName = item->text(); // Get the name of the character
-			QString charPath = QDir::currentPath() + "/data/characters/" + charName;
+			// Drop any pages built for the character before its files go away
+			this->pageCache.invalidate(charName);
+			if (charName == this->openCharacterName)
+			{
+				QStackedWidget * characterInformation = this->characterInformationStack();
+				while (characterInformation && characterInformation->count() > 0)
+				{
+					QWidget *widget = characterInformation->widget(0);
+					characterInformation->removeWidget(widget);
+					widget->deleteLater();
+				}
+				this->openCharacterName.clear();
+			}
 
-			QDir charDir(charPath);
-			if (charDir.removeRecursively())
-			{ // Remove the folder and its contents
-				// Remove the character from the UI list
-				// delete this->characters->takeItem(this->characters->row(item));
-				delete item;
+			if (CharacterStorage::instance().removeCharacter(charName))
+			{ // Remove the character's records, folder and its contents
+				// Remove the character from the index, which takes them out of the UI list
+				CharacterIndex::instance().remove(charName);
+				NotesSearchIndex::instance().removeCharacter(charName);
 
 				QMessageBox::information(this, "Character Deleted", "Character " + charName + " was deleted successfully."); // This is a message box that appears when the character is deleted
 			}
@@ -170,43 +179,33 @@ void CharacterSelect::deleteCharacter()
 	this->characters->selectionModel()->clear();
 }
 
-// Load the list of characters from the characters directory
+// Load the list of characters from the character index
 void CharacterSelect::loadCharacterList()
 {
-	this->characters->clear();
-
-	// Path to the characters directory
-	QString charDirPath = QDir::currentPath() + "/data/characters";
-	QDir charDir(charDirPath);
+	// The index holds the summary of every character, so no character folders are read here.
+	// Characters added or removed outside of the app are picked up by the index and sent to the model
+	QList<CharacterSummary> summaries = CharacterIndex::instance().summaries();
+	this->characterModel->setCharacters(summaries);
+	this->searchIndex.setCharacters(summaries);
+	this->applySearch();
+}
 
-	// Check if the directory exists
-	if (charDir.exists())
+// Filter the list down to the characters matching the search box
+void CharacterSelect::applySearch()
+{
+	QString query = this->search->text().trimmed();
+	if (query.isEmpty())
 	{
-		// Get the list of directories in the characters folder
-		// Because the name of each folder is the name of the character
-		QStringList characterFolders = charDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-		// Add each character to the list
-		for (const QString &charFolder : characterFolders)
-		{
-			this->characters->addItem(charFolder);
-		}
-
-		// Shows a message if no characters have been created
-		if (this->characters->count() == 0)
-		{
-			this->characters->addItem("No Characters Have been created");
-		}
+		this->filterModel->clearMatches();
 	}
 	else
 	{
-		// Make sure the characters directory exists
-		QMessageBox::warning(this, "Error", "Characters directory does not exist.");
+		this->filterModel->setMatches(this->searchIndex.search(query));
 	}
 }
 
 CharacterSelect::CharacterSelect(QWidget *parent)
-	: QWidget(parent)
+	: QWidget(parent), pageCache(cachedCharacters, cachedCharacterBytes)
 {
 	// Layout object for automatically centering and placing widgets
 	layout = new QGridLayout(this);
@@ -225,11 +224,28 @@ CharacterSelect::CharacterSelect(QWidget *parent)
 	// layout->addWidget(settings, 5, 82, 5, 10);
 	layout->addWidget(settings, 15, 8, 5, 10);
 
-	// List of all of the characters
-	this->characters = new QListWidget();
+	// button for searching every character's notes
+	this->searchNotes = new QPushButton("Search Notes");
+	layout->addWidget(searchNotes, 20, 8, 5, 10);
+
+	// List of all of the characters, every row is the same size so the view only lays out the visible ones
+	this->characterModel = new CharacterListModel(this);
+	this->filterModel = new CharacterFilterModel(this);
+	this->filterModel->setSourceModel(this->characterModel);
+	this->characters = new QListView();
+	this->characters->setModel(this->filterModel);
+	this->characters->setUniformItemSizes(true);
+	this->characters->setLayoutMode(QListView::Batched);
+	this->characters->setIconSize(CharacterListModel::thumbnailSize());
 	// layout->addWidget(characters, 10, 20, 80, 60);
 	layout->addWidget(characters, 5, 30, 80, 60);
 
+	// search box that filters the list by name, class, race or level
+	this->search = new QLineEdit(this);
+	this->search->setPlaceholderText("Search by name, class, race or level (ex. 3-5)");
+	this->search->setClearButtonEnabled(true);
+	layout->addWidget(this->search, 1, 30, 3, 60);
+
 	// button to delete selected character
 	this->deleteChar = new QPushButton("Delete Character", this);
 	// layout->addWidget(this->deleteChar, 87, 20, 10, 60);
@@ -240,6 +256,21 @@ CharacterSelect::CharacterSelect(QWidget *parent)
 
 	loadCharacterList();
 
+	// keep the list in step with the character index
+	CharacterIndex &index = CharacterIndex::instance();
+	auto updateCharacter = [this](const QString &name) {
+		CharacterSummary summary = CharacterIndex::instance().summary(name);
+		this->characterModel->updateCharacter(summary);
+		this->searchIndex.insert(summary);
+		this->applySearch();
+	};
+	connect(&index, &CharacterIndex::characterAdded, this, updateCharacter);
+	connect(&index, &CharacterIndex::characterChanged, this, updateCharacter);
+	connect(&index, &CharacterIndex::characterRemoved, this, [this](const QString &name) {
+		this->characterModel->removeCharacter(name);
+		this->searchIndex.remove(name);
+	});
+
 	/*
 		THE AREA BELOW SHOULD BE USED FOR THE CONNECT FUNCTIONS IE. EVENT HANDLERS
 	*/
@@ -248,30 +279,29 @@ CharacterSelect::CharacterSelect(QWidget *parent)
 	connect(this->deleteChar, SIGNAL(clicked()), SLOT(deleteCharSlot()));
 
 	// enable the delete button when a character is clicked
-	connect(this->characters, SIGNAL(itemClicked(QListWidgetItem *)), SLOT(selectChar()));
+	connect(this->characters, SIGNAL(clicked(QModelIndex)), SLOT(selectChar()));
 
 	// double click event to view character
-	connect(this->characters, SIGNAL(itemDoubleClicked(QListWidgetItem *)), SLOT(openChar()));
+	connect(this->characters, SIGNAL(doubleClicked(QModelIndex)), SLOT(openChar()));
 
 	// create character button click event
 	connect(this->createChar, SIGNAL(clicked()), SLOT(gotoAddCharacter()));
 
 	// settings button click event
 	connect(this->settings, SIGNAL(clicked()), SLOT(gotoSettings()));
+
+	// search notes button click event
+	connect(this->searchNotes, SIGNAL(clicked()), SLOT(gotoSearchNotes()));
+
+	// filter the list as the user types
+	connect(this->search, SIGNAL(textChanged(QString)), SLOT(applySearch()));
 }
 
 void CharacterSelect::deleteCharSlot()
 {
-	// call the delete character function
+	// call the delete character function, the model shows a message if there are no characters left
 	this->deleteCharacter();
 
-	// if there are no characters left, add a message to the list
-	if (characters->count() == 0)
-	{
-		QListWidgetItem *nochars = new QListWidgetItem("No Characters Have been created");
-		this->characters->addItem(nochars);
-	}
-
 	// disable delete button after character deletion
 	this->deleteChar->setEnabled(false);
 }
@@ -281,10 +311,33 @@ void CharacterSelect::selectChar()
 	this->deleteChar->setEnabled(true);
 }
 
+// Returns the characterInformation stack that holds the pages of the open character
+QStackedWidget *CharacterSelect::characterInformationStack()
+{
+	QStackedWidget * stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
+	if (!stackedWidget || !stackedWidget->widget(2))
+	{
+		qDebug() << "No characterInformation stack found";
+		return nullptr;
+	}
+	return qobject_cast<QStackedWidget *>(stackedWidget->widget(2));
+}
+
 void CharacterSelect::openChar()
 {
 	// get the name of the character
-	QString name = characters->currentItem()->text();
+	QString name = this->characterModel->characterName(this->characters->currentIndex());
+	if (name.isEmpty())
+	{
+		return;
+	}
+	this->openCharacter(name);
+}
+
+void CharacterSelect::openCharacter(const QString &name)
+{
+	// Make sure the list shows what is on disk in case the watcher missed an edit
+	CharacterIndex::instance().update(name);
 
 	// clear the selection and focus after getting character name
 	this->characters->selectionModel()->clear();
@@ -295,45 +348,78 @@ void CharacterSelect::openChar()
 
 	// Start the process of creating the viewCharacter page and switching to it
 	QStackedWidget * stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
-	if (stackedWidget)
+	QStackedWidget * characterInformation = this->characterInformationStack();
+	if (stackedWidget && characterInformation)
 	{
-		if(!stackedWidget->widget(2))
-		{
-			qDebug() << "No characterInformation stack found";
-			return;
-		}
-		// get the characterInformation stack
-		QStackedWidget * characterInformation = qobject_cast<QStackedWidget *>(stackedWidget->widget(2));
-
-		// Loop through all widgets and delete them
-    	while (characterInformation->count() > 0) 
+		// Take the previous character's pages out of the stack and keep them in the cache
+		QList<QWidget *> previousPages;
+		while (characterInformation->count() > 0)
 		{
 			QWidget *widget = characterInformation->widget(0); // Always get the first widget
 			characterInformation->removeWidget(widget); // Remove it from the stack
-			delete widget; // Delete the widget
-    	}
-		
-
-		// Create the viewCharacter page, viewInventory page, and viewNotes page
-		ViewCharacter *newViewCharacter = new ViewCharacter(nullptr, name);
-		ViewInventory *newViewInventory = new ViewInventory(nullptr, name);
-		ViewSpells *newViewSpells = new ViewSpells(nullptr, name);
-		ViewNotes *newViewNotes = new ViewNotes(nullptr, name);
-
-		// Add the viewCharacter page, viewInventory page, and viewNotes page to the stacked widget
-		characterInformation->addWidget(newViewCharacter);
-		characterInformation->addWidget(newViewInventory);
-		characterInformation->addWidget(newViewSpells);
-		characterInformation->addWidget(newViewNotes);
-
+			previousPages.append(widget);
+		}
+		if (!this->openCharacterName.isEmpty())
+		{
+			this->pageCache.store(this->openCharacterName, previousPages);
+		}
+		else
+		{
+			qDeleteAll(previousPages);
+		}
+		this->openCharacterName = name;
 
-		stackedWidget->setCurrentIndex(2); // viewCharacter in the characterInformation stack which is on index 2
+		// Switching back to a recently viewed character is just a widget swap
+		QList<QWidget *> cachedPages = this->pageCache.take(name);
+		if (!cachedPages.isEmpty())
+		{
+			for (QWidget *page : cachedPages)
+			{
+				characterInformation->addWidget(page);
+			}
+			characterInformation->setCurrentIndex(ViewCharacter::CharacterPage);
+			stackedWidget->setCurrentIndex(2);
+		}
+		else
+		{
+			// Only the viewCharacter page is built now, the inventory, spells, and notes pages
+			// are placeholders until ViewCharacter navigates to them
+			ViewCharacter *newViewCharacter = new ViewCharacter(nullptr, name);
+			characterInformation->addWidget(newViewCharacter);
+			characterInformation->addWidget(ViewCharacter::createPlaceholder());
+			characterInformation->addWidget(ViewCharacter::createPlaceholder());
+			characterInformation->addWidget(ViewCharacter::createPlaceholder());
+
+			stackedWidget->setCurrentIndex(2); // viewCharacter in the characterInformation stack which is on index 2
+
+			// Build the other pages in the background once the sheet has been drawn
+			QTimer::singleShot(prewarmDelay, newViewCharacter, &ViewCharacter::prewarmPages);
+		}
 	}
 
 	// disable delete button since itemClicked collides with itemDoubleClicked
 	deleteChar->setEnabled(false);
 }
 
+void CharacterSelect::openNote(const QString &character, const QString &section, int offset, int length)
+{
+	this->openCharacter(character);
+	QStackedWidget * characterInformation = this->characterInformationStack();
+	if (!characterInformation || this->openCharacterName != character)
+	{
+		return;
+	}
+
+	// Go to the notes page, building it if the character was just opened, and show the section
+	ViewCharacter *sheet = qobject_cast<ViewCharacter *>(characterInformation->widget(ViewCharacter::CharacterPage));
+	ViewNotes *notes = sheet ? qobject_cast<ViewNotes *>(sheet->ensurePage(ViewCharacter::NotesPage)) : nullptr;
+	if (notes)
+	{
+		characterInformation->setCurrentIndex(ViewCharacter::NotesPage);
+		notes->openSection(section, offset, length);
+	}
+}
+
 void CharacterSelect::gotoAddCharacter()
 {
 	QStackedWidget *stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
@@ -361,4 +447,14 @@ void CharacterSelect::gotoSettings()
 	{
 		stackedWidget->setCurrentIndex(3); // settings is the fourth page so index 3
 	}
+}
+
+void CharacterSelect::gotoSearchNotes()
+{
+	// find the parent stacked widget and switch to the notes search page
+	QStackedWidget *stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
+	if (stackedWidget)
+	{
+		stackedWidget->setCurrentIndex(4); // notes search is the fifth page so index 4
+	}
 }
\ No newline at end of file
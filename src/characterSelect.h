@@ -1,19 +1,21 @@
 /*
 Name: characterSelect.h
 Description: Main landing page for the application, allowing users to create, delete, and manage characters.
-			 Also provides navigation to settings.
+			 Also provides navigation to settings and the notes search.
 Authors: Carson Treece, Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 10/22/2024
-Last Modified: 11/24/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef CHARACTER_SELECT
 #define CHARACTER_SELECT
 
 #include <QWidget>
+#include <QStackedWidget>
 #include <QPushButton>
-#include <QListWidget>
+#include <QListView>
+#include <QLineEdit>
 #include <QLayout>
 #include <QLabel>
 #include <QDialog>
@@ -22,13 +24,18 @@ Last Modified: 11/24/2024
 #include <QInputDialog>
 #include <QMessageBox>
 
+#include "characterPageCache.h"
+#include "characterListModel.h"
+#include "characterFilterModel.h"
+#include "characterSearchIndex.h"
+
 class CharacterSelect : public QWidget {
 	Q_OBJECT
 public:
 	explicit CharacterSelect(QWidget * parent = 0);
 	// ~CharacterSelect();
 
-	QListWidget * getCharacters() { return this->characters; }
+	QListView * getCharacters() { return this->characters; }
 
 	void addCharacter(QString charName = 0);
 	void deleteCharacter();
@@ -37,16 +44,31 @@ private:
 	QGridLayout * layout;
 	QPushButton * createChar;
 	QPushButton * settings;
-	QListWidget * characters;
+	QPushButton * searchNotes;
+	QListView * characters;
+	CharacterListModel * characterModel;
+	// Search box, the index it searches, and the model that hides the characters it did not match
+	QLineEdit * search;
+	CharacterSearchIndex searchIndex;
+	CharacterFilterModel * filterModel;
 	QPushButton * deleteChar;
+	// Pages of recently viewed characters, and the name of the character whose pages are in the stack
+	CharacterPageCache pageCache;
+	QString openCharacterName;
+	QStackedWidget * characterInformationStack();
 public slots:
 	void loadCharacterList();
+	// Opens a character on their sheet, or on a note section found by the notes search
+	void openCharacter(const QString &name);
+	void openNote(const QString &character, const QString &section, int offset, int length);
 private slots:
 	void deleteCharSlot();
 	void selectChar();
+	void applySearch();
 	void openChar();
 	void gotoAddCharacter();
 	void gotoSettings();
+	void gotoSearchNotes();
 };
 
 #endif // CHARACTER_SELECT_H
\ No newline at end of file
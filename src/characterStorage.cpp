@@ -0,0 +1,237 @@
+/*
+Name: characterStorage.cpp
+Description: Where a character's records (character.csv, inventory.csv, spells.csv, slots.csv, notes)
+			 are kept. Either one folder per character, or a single campaign file holding every character,
+			 picked on the settings page. Portraits always stay in the character's folder.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterStorage.h"
+#include "campaignStore.h"
+#include "directoryStorage.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <utility>
+
+static QString selectedBackendPath()
+{
+	return QDir::currentPath() + "/data/selectedStorage.txt";
+}
+
+// The storage holding the characters, only one of them does so the other can never show an old copy
+static QString holdingBackendPath()
+{
+	return QDir::currentPath() + "/data/storageInUse.txt";
+}
+
+static bool readBackend(const QString &path, CharacterStorage::Backend &backend)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return false;
+	}
+	QString name = QTextStream(&file).readLine().trimmed();
+	backend = name == CharacterStorage::backendName(CharacterStorage::Campaign) ? CharacterStorage::Campaign
+																				 : CharacterStorage::Folders;
+	return true;
+}
+
+static void writeBackend(const QString &path, CharacterStorage::Backend backend)
+{
+	QFile file(path);
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		QTextStream(&file) << CharacterStorage::backendName(backend);
+	}
+	else
+	{
+		qWarning() << "Could not save" << path << file.errorString();
+	}
+}
+
+// Removes every record of a character, the portrait and the folder holding it are left alone
+static bool removeRecords(CharacterStorage &storage, const QString &character)
+{
+	bool removed = true;
+	for (const QString &record : storage.records(character))
+	{
+		removed = storage.removeRecord(character, record) && removed;
+	}
+	return removed;
+}
+
+CharacterStorage &CharacterStorage::instance()
+{
+	static CharacterStorage *storage = nullptr;
+	if (!storage)
+	{
+		storage = create(selectedBackend());
+
+		Backend holding;
+		if (!readBackend(holdingBackendPath(), holding))
+		{
+			// Saves from before this was recorded, the picked storage held the characters unless it was empty
+			holding = storage->backend();
+			if (storage->isEmpty())
+			{
+				holding = storage->backend() == Folders ? Campaign : Folders;
+			}
+		}
+
+		// Move the characters over when the storage was switched
+		if (holding != storage->backend())
+		{
+			CharacterStorage *source = create(holding);
+			if (source->backend() != holding)
+			{
+				// Still recorded as holding them, so they are moved once it opens again
+				qWarning() << "Could not open" << backendName(holding) << "to move the characters out of it";
+			}
+			else if (!migrate(*source, *storage))
+			{
+				qWarning() << "Could not move the characters, keeping them in" << backendName(holding);
+				std::swap(storage, source);
+			}
+			delete source;
+		}
+		else
+		{
+			writeBackend(holdingBackendPath(), holding);
+		}
+	}
+	return *storage;
+}
+
+CharacterStorage::Backend CharacterStorage::selectedBackend()
+{
+	Backend backend = Folders; // Default to folders if no file is found
+	readBackend(selectedBackendPath(), backend);
+	return backend;
+}
+
+void CharacterStorage::setSelectedBackend(Backend backend)
+{
+	writeBackend(selectedBackendPath(), backend);
+}
+
+QString CharacterStorage::backendName(Backend backend)
+{
+	return backend == Campaign ? "Campaign File" : "Character Folders";
+}
+
+CharacterStorage *CharacterStorage::create(Backend backend)
+{
+	if (backend == Campaign)
+	{
+		CampaignStore *store = new CampaignStore(QDir::currentPath() + "/data/campaign.db");
+		if (store->isOpen())
+		{
+			return store;
+		}
+		qWarning() << "Could not open the campaign file, using character folders instead";
+		delete store;
+	}
+	return new DirectoryStorage();
+}
+
+/**
+ * This function moves every character from one storage into another. Anything the other storage already
+ * held is an old copy and is replaced, the source is only emptied once every character was copied
+ */
+bool CharacterStorage::migrate(CharacterStorage &from, CharacterStorage &to)
+{
+	const QStringList names = from.characters();
+	qDebug() << "Moving" << names.size() << "characters from" << backendName(from.backend()) << "to"
+			 << backendName(to.backend());
+
+	for (const QString &name : names)
+	{
+		QMap<QString, QByteArray> records;
+		for (const QString &record : from.records(name))
+		{
+			bool ok = false;
+			records.insert(record, from.read(name, record, &ok));
+			if (!ok)
+			{
+				qWarning() << "Could not read" << record << "of character" << name;
+				return false;
+			}
+		}
+		if (!to.write(name, records))
+		{
+			qWarning() << "Could not copy character" << name;
+			return false;
+		}
+		for (const QString &record : to.records(name))
+		{
+			if (!records.contains(record))
+			{
+				to.removeRecord(name, record);
+			}
+		}
+	}
+	for (const QString &name : to.characters())
+	{
+		if (!names.contains(name))
+		{
+			removeRecords(to, name);
+		}
+	}
+
+	// Recorded before the source is emptied, a crash in between leaves the characters where they were copied
+	writeBackend(holdingBackendPath(), to.backend());
+	for (const QString &name : names)
+	{
+		if (!removeRecords(from, name))
+		{
+			qWarning() << "Could not remove the old copy of character" << name;
+		}
+	}
+	return true;
+}
+
+bool CharacterStorage::write(const QString &character, const QString &record, const QByteArray &data)
+{
+	QMap<QString, QByteArray> records;
+	records.insert(record, data);
+	return this->write(character, records);
+}
+
+QStringList CharacterStorage::readLines(const QString &character, const QString &record, bool *ok) const
+{
+	QByteArray data = this->read(character, record, ok);
+	QStringList lines;
+	QTextStream in(&data, QIODevice::ReadOnly);
+	while (!in.atEnd())
+	{
+		lines.append(in.readLine());
+	}
+	return lines;
+}
+
+bool CharacterStorage::writeLines(const QString &character, const QString &record, const QStringList &lines)
+{
+	QByteArray data;
+	for (const QString &line : lines)
+	{
+		data += line.toUtf8() + "\n";
+	}
+	return this->write(character, record, data);
+}
+
+bool CharacterStorage::appendLine(const QString &character, const QString &record, const QString &line)
+{
+	return this->append(character, record, line.toUtf8() + "\n");
+}
+
+QString CharacterStorage::characterPath(const QString &character)
+{
+	return QDir::currentPath() + "/data/characters/" + character;
+}
@@ -0,0 +1,84 @@
+/*
+Name: characterStorage.h
+Description: Where a character's records (character.csv, inventory.csv, spells.csv, slots.csv, notes)
+			 are kept. Either one folder per character, or a single campaign file holding every character,
+			 picked on the settings page. Portraits always stay in the character's folder.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERSTORAGE_H
+#define CHARACTERSTORAGE_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+class CharacterStorage
+{
+public:
+	enum Backend
+	{
+		Folders,  // data/characters/<name>/<record>
+		Campaign  // every record in data/campaign.db
+	};
+
+	struct RecordInfo
+	{
+		bool exists = false;
+		qint64 size = 0;
+		qint64 lastModified = 0; // ms since epoch
+	};
+
+	/*
+	 * Returns the storage picked on the settings page. If the characters are held by the other storage they
+	 * are moved into it first, so switching storage never loses anyone or brings back an old copy of them.
+	 * Only use it from the GUI thread.
+	 */
+	static CharacterStorage &instance();
+	// The storage used from the next launch on
+	static Backend selectedBackend();
+	static void setSelectedBackend(Backend backend);
+	static QString backendName(Backend backend);
+
+	virtual ~CharacterStorage() = default;
+
+	virtual Backend backend() const = 0;
+	// Names of every character, in name order
+	virtual QStringList characters() const = 0;
+	// Names of every record of a character
+	virtual QStringList records(const QString &character) const = 0;
+	virtual RecordInfo info(const QString &character, const QString &record) const = 0;
+	// Changes whenever a character is added or removed, kept between launches
+	virtual qint64 generation() const = 0;
+	virtual QByteArray read(const QString &character, const QString &record, bool *ok = nullptr) const = 0;
+	// Writes the records, a failure leaves them all as they were. The campaign file also writes them as
+	// one transaction, character folders replace them one at a time so a crash can leave some written
+	virtual bool write(const QString &character, const QMap<QString, QByteArray> &records) = 0;
+	// Adds to the end of a record without rewriting what is already there, creating it if needed
+	virtual bool append(const QString &character, const QString &record, const QByteArray &data) = 0;
+	// Removes one record, a record that does not exist counts as removed
+	virtual bool removeRecord(const QString &character, const QString &record) = 0;
+	// Removes the character's records and folder
+	virtual bool removeCharacter(const QString &character) = 0;
+
+	bool exists(const QString &character, const QString &record) const { return this->info(character, record).exists; }
+	bool isEmpty() const { return this->characters().isEmpty(); }
+	bool write(const QString &character, const QString &record, const QByteArray &data);
+	// Text records are read and written a line at a time by the pages
+	QStringList readLines(const QString &character, const QString &record, bool *ok = nullptr) const;
+	bool writeLines(const QString &character, const QString &record, const QStringList &lines);
+	bool appendLine(const QString &character, const QString &record, const QString &line);
+
+	// Folder holding the character's portrait, and their records when stored in folders
+	static QString characterPath(const QString &character);
+
+private:
+	static CharacterStorage *create(Backend backend);
+	static bool migrate(CharacterStorage &from, CharacterStorage &to);
+};
+
+#endif // CHARACTERSTORAGE_H
@@ -0,0 +1,58 @@
+/*
+Name: characterSummary.cpp
+Description: The few fields of a character shown outside of their sheet, read from the first line of character.csv.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "characterSummary.h"
+#include "characterStorage.h"
+
+#include <QStringList>
+
+CharacterSummary CharacterSummary::read(const QString &name)
+{
+	CharacterSummary summary;
+	summary.name = name;
+
+	CharacterStorage &storage = CharacterStorage::instance();
+	CharacterStorage::RecordInfo info = storage.info(name, "character.csv");
+	summary.lastModified = info.lastModified;
+	summary.fileSize = info.size;
+	QStringList lines = storage.readLines(name, "character.csv");
+	if (lines.isEmpty())
+	{
+		return summary;
+	}
+
+	// Name,Str,Dex,Con,Int,Wis,Cha,Level:XP,MaxHP:CurHP:TempHP,Class,Subclass,Race,Subrace
+	QStringList fields = lines[0].trimmed().split(",");
+	if (fields.size() < 13)
+	{
+		return summary;
+	}
+
+	for (int i = 1; i <= 6; i++)
+	{
+		summary.abilityScores.append(fields[i].toInt());
+	}
+	summary.level = fields[7].split(":")[0].toInt();
+	summary.maxHitPoints = fields[8].split(":")[0].toInt();
+	summary.characterClass = fields[9];
+	summary.subclass = fields[10];
+	summary.race = fields[11];
+	summary.subrace = fields[12];
+	summary.valid = true;
+	return summary;
+}
+
+QString CharacterSummary::description() const
+{
+	if (!this->valid)
+	{
+		return QString();
+	}
+	return "Level " + QString::number(this->level) + " " + this->race + " " + this->characterClass;
+}
@@ -0,0 +1,39 @@
+/*
+Name: characterSummary.h
+Description: The few fields of a character shown outside of their sheet, read from the first line of character.csv.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHARACTERSUMMARY_H
+#define CHARACTERSUMMARY_H
+
+#include <QList>
+#include <QString>
+
+struct CharacterSummary
+{
+	QString name;
+	QString characterClass;
+	QString subclass;
+	QString race;
+	QString subrace;
+	int level = 0;
+	int maxHitPoints = 0;
+	QList<int> abilityScores;  // Str, Dex, Con, Int, Wis, Cha
+	qint64 lastModified = 0;   // when character.csv was last saved, in ms since epoch
+	qint64 fileSize = 0;	   // size of character.csv, together with lastModified tells if it changed
+	bool valid = false;		   // false if character.csv could not be read
+
+	int proficiencyBonus() const { return 2 + (qMax(this->level, 1) - 1) / 4; }
+
+	// Reads character.csv through the character storage, so only from the GUI thread
+	static CharacterSummary read(const QString &name);
+
+	// ex. "Level 9 Human Wizard"
+	QString description() const;
+};
+
+#endif // CHARACTERSUMMARY_H
@@ -0,0 +1,96 @@
+/*
+Name: checkBoxDelegate.cpp
+Description: Item delegate that paints a check state as a centered check box and toggles it on click or
+			 space, so a table of yes/no columns needs no check box widgets.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "checkBoxDelegate.h"
+
+#include <QApplication>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOption>
+
+CheckBoxDelegate::CheckBoxDelegate(QObject *parent)
+	: QStyledItemDelegate(parent)
+{
+}
+
+QRect CheckBoxDelegate::indicatorRect(const QStyleOptionViewItem &option)
+{
+	QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+	QStyleOptionButton button;
+	QRect indicator = style->subElementRect(QStyle::SE_CheckBoxIndicator, &button, option.widget);
+	indicator.moveCenter(option.rect.center());
+	return indicator;
+}
+
+void CheckBoxDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+	// Draw the cell's background and selection the way every other cell gets them
+	QStyleOptionViewItem cell = option;
+	this->initStyleOption(&cell, index);
+	cell.features &= ~QStyleOptionViewItem::HasCheckIndicator;
+	cell.text.clear();
+	QStyle *style = option.widget ? option.widget->style() : QApplication::style();
+	style->drawControl(QStyle::CE_ItemViewItem, &cell, painter, option.widget);
+
+	QVariant state = index.data(Qt::CheckStateRole);
+	if (!state.isValid())
+	{
+		return;
+	}
+
+	// Check boxes the user can not toggle are drawn disabled, like a disabled QCheckBox
+	QStyleOptionButton button;
+	button.rect = indicatorRect(option);
+	button.state = state.toInt() == Qt::Checked ? QStyle::State_On : QStyle::State_Off;
+	if (index.flags() & Qt::ItemIsUserCheckable)
+	{
+		button.state |= QStyle::State_Enabled;
+	}
+	style->drawPrimitive(QStyle::PE_IndicatorCheckBox, &button, painter, option.widget);
+}
+
+bool CheckBoxDelegate::editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+								   const QModelIndex &index)
+{
+	Qt::ItemFlags flags = index.flags();
+	if (!(flags & Qt::ItemIsUserCheckable) || !(flags & Qt::ItemIsEnabled))
+	{
+		return false;
+	}
+
+	switch (event->type())
+	{
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseButtonDblClick:
+		// Taken so a double click does not also start editing the cell
+		return indicatorRect(option).contains(static_cast<QMouseEvent *>(event)->pos());
+	case QEvent::MouseButtonRelease:
+		if (static_cast<QMouseEvent *>(event)->button() != Qt::LeftButton ||
+			!indicatorRect(option).contains(static_cast<QMouseEvent *>(event)->pos()))
+		{
+			return false;
+		}
+		break;
+	case QEvent::KeyPress:
+		if (static_cast<QKeyEvent *>(event)->key() != Qt::Key_Space &&
+			static_cast<QKeyEvent *>(event)->key() != Qt::Key_Select)
+		{
+			return false;
+		}
+		break;
+	default:
+		return false;
+	}
+
+	int state = index.data(Qt::CheckStateRole).toInt() == Qt::Checked ? Qt::Unchecked : Qt::Checked;
+	return model->setData(index, state, Qt::CheckStateRole);
+}
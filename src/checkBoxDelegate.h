@@ -0,0 +1,30 @@
+/*
+Name: checkBoxDelegate.h
+Description: Item delegate that paints a check state as a centered check box and toggles it on click or
+			 space, so a table of yes/no columns needs no check box widgets.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef CHECKBOXDELEGATE_H
+#define CHECKBOXDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+class CheckBoxDelegate : public QStyledItemDelegate
+{
+	Q_OBJECT
+public:
+	explicit CheckBoxDelegate(QObject *parent = nullptr);
+
+	void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+	bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option,
+					 const QModelIndex &index) override;
+
+private:
+	static QRect indicatorRect(const QStyleOptionViewItem &option);
+};
+
+#endif // CHECKBOXDELEGATE_H
@@ -4,20 +4,22 @@ Description: Implementation of the AddCharacter class, which allows users to cre
 Authors: Josh Park
 Other Sources: ...
 Date Created: 11/20/2024
-Last Modified: 11/23/2024
+Last Modified: 10/17/2026
 */
 
 #include "addCharacter.h"
+#include "referenceDatabase.h"
 
-#include <iostream>
-
-#include <QDir>
-#include <QFile>
+#include <QDebug>
 #include <QLayout>
 #include <QPushButton>
-#include <QRegularExpression>
 #include <QStandardItemModel>
 
+// Weapon names of one type from Items.tsv, such as "Simple Melee Weapon"
+static const QStringList &weapons(const QString &type) {
+	return ReferenceDatabase::instance().itemCompendium().names(type);
+}
+
 /**
  * Constructor for the class
  */
@@ -107,7 +109,7 @@ ClassWidget::ClassWidget(QWidget * parent) :
 	mainLayout->addLayout(description, 1, 1, 1, 4);
 	mainLayout->addWidget(navbar, 2, 0, 1, -1, {Qt::AlignBottom});
 
-	//loading the classes from the tsv file
+	//loading the classes from the reference database
 	this->loadClasses();
 
 	// Initialize with the first class's details
@@ -157,91 +159,33 @@ void ClassWidget::nextPage()
 	qDebug() << "Items: " << *this->getItems() << Qt::endl;
 }
 
+/**
+ * This function fills the class combo box from the shared reference database
+ */
 void ClassWidget::loadClasses() {
-	QFile file("data/databases/ClassInventory.tsv"); // read in the file
-	qDebug() << "Current working directory:" << QDir::currentPath();
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-		// error checking for debugging
-		std::cerr << "Failed to open file" << std::endl;
-		return;
-	}
-
-	QTextStream in(&file); // read in the file
-	bool isHeader = true;  // our first line is a header
-
-	while (!in.atEnd()) {
-		QString line = in.readLine(); // read in the line
-		if (isHeader) {
-			isHeader = false; // we are no longer on the header
-			continue;		  // skip the header
-		}
-
-		QStringList fields = line.split("\t"); // split the line by \t
-		if (fields.size() < 10) {
-			continue; // ensure we get all the fields
-		}
-
-		QList<QString> * armors = new QList<QString>(fields[3].split(", "));
-
-		QList<QString> * weapons = new QList<QString>(fields[4].split(", "));
-
-		QList<QString> * tools = new QList<QString>(fields[5].split(", "));
-
-		QList<QString> * savingThrows = new QList<QString>(fields[6].split(", "));
-
-		QList<QString> * skills = new QList<QString>(fields[8].split(", "));
-		// qDebug() << "matching " << fields[9];
-		QList<QList<QString> *> * choices = new QList<QList<QString> *>;
-		QRegularExpression re("\\([^)]+\\)");
-		QRegularExpressionMatchIterator match = re.globalMatch(fields[9]);
-		// qDebug() << choiceList;
-		while (match.hasNext()) {
-			QString itemsStr = match.next().captured();
-			itemsStr = itemsStr.mid(1, itemsStr.size()-2);
-			// qDebug() << itemsStr;
-			QList<QString> items = itemsStr.split(", ");
-			QList<QString> * choice = new QList<QString>;
-			for (QString item : items) {
-				choice->append(item);
-			}
-			choices->append(choice);
-			// qDebug() << *choice << Qt::endl;
-		}
-
-		QList<QString> * given = new QList<QString>(fields[10].split(", "));
-
-		ClassInfo * info = new ClassInfo {
-			fields[1],
-			fields[2],
-			armors,
-			weapons,
-			tools,
-			savingThrows,
-			fields[7].toInt(),
-			skills,
-			choices,
-			given,
-			fields[11]
-		};
-
-		QString name = fields[0];
-		this->classes[name] = info;
+	for (const QString &name : ReferenceDatabase::instance().classNames()) {
 		this->classComboBox->addItem(name);
 	}
 }
 
+/**
+ * This function returns the database entry for the selected class
+ */
+const ClassInfo * ClassWidget::currentClassInfo() {
+	return ReferenceDatabase::instance().classInfo(this->classComboBox->currentText());
+}
+
 /**
  * This function updates all information in ClassWidget to match what class is selected
  */
 void ClassWidget::updateClassInfo(const QString &name) {
-	if (!this->classes.contains(name))
+	const ClassInfo * info = ReferenceDatabase::instance().classInfo(name);
+	if (!info)
 	{
-		qWarning() << "Background not found:" << name;
+		qWarning() << "Class not found:" << name;
 		return;
 	}
 
-	ClassInfo * info = this->classes[name];
-
 	this->header->setText("<h1>" + name + " " + info->book + " pg " + info->page + "</h1>");
 
 	this->portrait->getImage(name);
@@ -249,21 +193,21 @@ void ClassWidget::updateClassInfo(const QString &name) {
 	this->summary->setText("<h3>Summary:</h3><br>" + info->summary);
 
 	this->armor->setText("<h4>Armor:</h4>");
-	for (QString prof : *info->armorProficiencies) {
+	for (QString prof : info->armorProficiencies) {
 		this->armor->setText(this->armor->text() + "<br>" + prof);
 	}
 
 	this->weapons->setText("<h4>Weapons:</h4>");
-	for (QString prof : *info->weaponProficiencies) {
+	for (QString prof : info->weaponProficiencies) {
 		this->weapons->setText(this->weapons->text() + "<br>" + prof);
 	}
 	this->tools->setText("<h4>Tools:</h4>");
-	for (QString prof : *info->toolProficiencies) {
+	for (QString prof : info->toolProficiencies) {
 		this->tools->setText(this->tools->text() + "<br>" + prof);
 	}
 
 	this->savingThrows->setText("<h4>Saving Throws:</h4>");
-	for (QString prof : *info->savingThrows) {
+	for (QString prof : info->savingThrows) {
 		this->savingThrows->setText(this->savingThrows->text() + "<br>" + prof);
 	}
 
@@ -277,7 +221,7 @@ void ClassWidget::updateClassInfo(const QString &name) {
 	this->skillsList = new QList<UpComboBox *>();
 	for (int i = 0; i < info->numSkills; i++) {
 		UpComboBox * skillBox = new UpComboBox();
-		for (QString skill : *info->skillProficiencies) {
+		for (QString skill : info->skillProficiencies) {
 			if (skill == "All") {
 				skillBox->addItems(allSkills);
 				continue;
@@ -314,26 +258,26 @@ void ClassWidget::updateClassInfo(const QString &name) {
 		delete this->multipleChoiceBox;
 	}
 	multipleChoiceBox = nullptr;
-	for (auto choice : *info->equipmentChoices) {
+	for (const QList<QString> &choice : info->equipmentChoices) {
 		UpComboBox * choiceBox = new UpComboBox();
 		bool multipleItems = false;
-		for (QString item : *choice) {
+		for (QString item : choice) {
 			if (item == "Simple") {
-				choiceBox->addItems(simpleMelee);
-				choiceBox->addItems(simpleRanged);
+				choiceBox->addItems(weapons("Simple Melee Weapon"));
+				choiceBox->addItems(weapons("Simple Ranged Weapon"));
 				continue;
 			}
 			if (item == "Simple Melee") {
-				choiceBox->addItems(simpleMelee);
+				choiceBox->addItems(weapons("Simple Melee Weapon"));
 				continue;
 			}
 			if (item == "Martial") {
-				choiceBox->addItems(martialMelee);
-				choiceBox->addItems(martialRanged);
+				choiceBox->addItems(weapons("Martial Melee Weapon"));
+				choiceBox->addItems(weapons("Martial Ranged Weapon"));
 				continue;
 			}
 			if (item == "Martial Melee") {
-				choiceBox->addItems(martialMelee);
+				choiceBox->addItems(weapons("Martial Melee Weapon"));
 				continue;
 			}
 			if (QList<QString>{"2 Martial", "Martial and Shield", "2 Simple Melee"}.contains(item)) {
@@ -354,7 +298,7 @@ void ClassWidget::updateClassInfo(const QString &name) {
 
 	this->givenEquipment->clear();
 	bool first = true;
-	for (QString prof : *info->givenEquipment) {
+	for (QString prof : info->givenEquipment) {
 		if (first) {
 			first = false;
 			this->givenEquipment->setText(this->givenEquipment->text() + prof);
@@ -401,10 +345,10 @@ void ClassWidget::updateChoice() {
 	if (option == "2 Simple Melee") {
 		UpComboBox * item1 = new UpComboBox();
 		UpComboBox * item2 = new UpComboBox();
-		item1->addItems(simpleMelee);
-		item1->addItems(simpleRanged);
-		item2->addItems(simpleMelee);
-		item2->addItems(simpleRanged);
+		item1->addItems(weapons("Simple Melee Weapon"));
+		item1->addItems(weapons("Simple Ranged Weapon"));
+		item2->addItems(weapons("Simple Melee Weapon"));
+		item2->addItems(weapons("Simple Ranged Weapon"));
 		this->choicesLayout->insertWidget(index+1, item1);
 		this->choicesLayout->insertWidget(index+2, item2);
 		this->multipleChoice->append(item1);
@@ -414,10 +358,10 @@ void ClassWidget::updateChoice() {
 	if (option == "2 Martial") {
 		UpComboBox * item1 = new UpComboBox();
 		UpComboBox * item2 = new UpComboBox();
-		item1->addItems(martialMelee);
-		item1->addItems(martialRanged);
-		item2->addItems(martialMelee);
-		item2->addItems(martialRanged);
+		item1->addItems(weapons("Martial Melee Weapon"));
+		item1->addItems(weapons("Martial Ranged Weapon"));
+		item2->addItems(weapons("Martial Melee Weapon"));
+		item2->addItems(weapons("Martial Ranged Weapon"));
 		this->choicesLayout->insertWidget(index+1, item1);
 		this->choicesLayout->insertWidget(index+2, item2);
 		this->multipleChoice->append(item1);
@@ -427,8 +371,8 @@ void ClassWidget::updateChoice() {
 	if (option == "Martial and Shield") {
 		UpComboBox * item1 = new UpComboBox();
 		QLabel * item2 = new QLabel("Shield");
-		item1->addItems(martialMelee);
-		item1->addItems(martialRanged);
+		item1->addItems(weapons("Martial Melee Weapon"));
+		item1->addItems(weapons("Martial Ranged Weapon"));
 		this->choicesLayout->insertWidget(index+1, item1);
 		this->choicesLayout->insertWidget(index+2, item2);
 		this->multipleChoice->append(item1);
@@ -459,9 +403,9 @@ QList<QString> * ClassWidget::getItems() {
 		}
 	}
 
-	ClassInfo * info = this->classes[this->classComboBox->currentText()];
-	if ((*info->givenEquipment)[0] != "None") {
-		items->append(*info->givenEquipment);
+	const ClassInfo * info = this->currentClassInfo();
+	if (info && info->givenEquipment[0] != "None") {
+		items->append(info->givenEquipment);
 	}
 	return items;
 }
@@ -482,37 +426,41 @@ QList<QString> * ClassWidget::getSkillProficincies() {
 /**
  * This function returns all proficiencies chosen
  */
-QList<QString> * ClassWidget::getSavingThrows() {
-	ClassInfo * info = this->classes[this->classComboBox->currentText()];
+const QList<QString> * ClassWidget::getSavingThrows() {
+	static const QList<QString> none;
+	const ClassInfo * info = this->currentClassInfo();
 
-	return info->savingThrows;
+	return info ? &info->savingThrows : &none;
 }
 
 /**
  * This function returns all tool proficiencies from chosen class
  */
-QList<QString> * ClassWidget::getToolProficincies() {
-	ClassInfo * info = this->classes[this->classComboBox->currentText()];
+const QList<QString> * ClassWidget::getToolProficincies() {
+	static const QList<QString> none;
+	const ClassInfo * info = this->currentClassInfo();
 
-	return info->toolProficiencies;
+	return info ? &info->toolProficiencies : &none;
 }
 
 /**
  * This function returns all weapon proficiencies from chosen class
  */
-QList<QString> * ClassWidget::getWeaponProficincies() {
-	ClassInfo * info = this->classes[this->classComboBox->currentText()];
+const QList<QString> * ClassWidget::getWeaponProficincies() {
+	static const QList<QString> none;
+	const ClassInfo * info = this->currentClassInfo();
 
-	return info->weaponProficiencies;
+	return info ? &info->weaponProficiencies : &none;
 }
 
 /**
  * This function returns all armor proficiencies from chosen class
  */
-QList<QString> * ClassWidget::getArmorProficincies() {
-	ClassInfo * info = this->classes[this->classComboBox->currentText()];
+const QList<QString> * ClassWidget::getArmorProficincies() {
+	static const QList<QString> none;
+	const ClassInfo * info = this->currentClassInfo();
 
-	return info->armorProficiencies;
+	return info ? &info->armorProficiencies : &none;
 }
 
 QString ClassWidget::getClass() {
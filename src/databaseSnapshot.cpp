@@ -0,0 +1,302 @@
+/*
+Name: databaseSnapshot.cpp
+Description: Versioned binary snapshot of every table in data/databases. The snapshot is
+			 memory-mapped and fields are read straight out of the mapping without copying.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "databaseSnapshot.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+#include <QtEndian>
+
+static const int headerSize = 6 * sizeof(quint32);
+static const int tableEntrySize = 4 * sizeof(quint32);
+static const int pairSize = 2 * sizeof(quint32);
+
+DatabaseSnapshot::DatabaseSnapshot(const QString &directory) : file(directory + "/databases.snapshot")
+{
+	if (!isStale(directory, this->file.fileName()) && this->file.open(QIODevice::ReadOnly))
+	{
+		const uchar *mapped = this->file.map(0, this->file.size());
+		if (mapped && this->open(mapped, this->file.size()))
+		{
+			return;
+		}
+
+		// Written by an older version or damaged, rebuild it below
+		qWarning() << "Database snapshot is invalid, rebuilding:" << this->file.fileName();
+		this->file.close();
+	}
+
+	QByteArray compiled = compile(directory);
+
+	// QSaveFile only replaces the old snapshot once the new one is completely written
+	QSaveFile output(this->file.fileName());
+	if (output.open(QIODevice::WriteOnly) && output.write(compiled) == compiled.size() && output.commit() &&
+		this->file.open(QIODevice::ReadOnly))
+	{
+		const uchar *mapped = this->file.map(0, this->file.size());
+		if (mapped && this->open(mapped, this->file.size()))
+		{
+			return;
+		}
+	}
+
+	qWarning() << "Failed to map database snapshot, using an in-memory copy:" << this->file.fileName();
+	this->fallback = compiled;
+	this->open(reinterpret_cast<const uchar *>(this->fallback.constData()), this->fallback.size());
+}
+
+/**
+ * This function checks whether any source table was changed after the snapshot was written
+ */
+bool DatabaseSnapshot::isStale(const QString &directory, const QString &snapshotPath)
+{
+	QFileInfo snapshot(snapshotPath);
+	if (!snapshot.exists())
+	{
+		return true;
+	}
+
+	const QFileInfoList sources = QDir(directory).entryInfoList({"*.tsv", "*.csv"}, QDir::Files);
+	for (const QFileInfo &source : sources)
+	{
+		if (source.lastModified() > snapshot.lastModified())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * This function parses every tsv/csv file in the directory and lays them out in the snapshot format
+ */
+QByteArray DatabaseSnapshot::compile(const QString &directory)
+{
+	QByteArray pool;
+	QVector<quint32> tableEntries;
+	QVector<quint32> rowEntries;
+	QVector<quint32> cellEntries;
+
+	const QFileInfoList sources = QDir(directory).entryInfoList({"*.tsv", "*.csv"}, QDir::Files, QDir::Name);
+	for (const QFileInfo &source : sources)
+	{
+		QFile table(source.filePath());
+		if (!table.open(QIODevice::ReadOnly))
+		{
+			qWarning() << "Failed to open database file:" << table.fileName();
+			continue;
+		}
+		const QByteArray text = table.readAll();
+		table.close();
+
+		const char separator = source.suffix() == "csv" ? ',' : '\t';
+
+		QByteArray name = source.fileName().toUtf8();
+		tableEntries << quint32(pool.size()) << quint32(name.size()) << quint32(rowEntries.size() / 2);
+		pool.append(name);
+
+		quint32 rowCount = 0;
+		bool isHeader = true; // our first line is a header
+		int lineStart = 0;
+		while (lineStart < text.size())
+		{
+			int lineEnd = text.indexOf('\n', lineStart);
+			if (lineEnd < 0)
+			{
+				lineEnd = text.size();
+			}
+			int nextLine = lineEnd + 1;
+			if (lineEnd > lineStart && text[lineEnd - 1] == '\r')
+			{
+				lineEnd--;
+			}
+
+			if (isHeader)
+			{
+				isHeader = false; // skip the header
+			}
+			else if (lineEnd > lineStart)
+			{
+				rowEntries << quint32(cellEntries.size() / 2);
+				quint32 cellCount = 0;
+				int fieldStart = lineStart;
+				while (true)
+				{
+					int fieldEnd = text.indexOf(separator, fieldStart);
+					if (fieldEnd < 0 || fieldEnd > lineEnd)
+					{
+						fieldEnd = lineEnd;
+					}
+					cellEntries << quint32(pool.size()) << quint32(fieldEnd - fieldStart);
+					pool.append(text.constData() + fieldStart, fieldEnd - fieldStart);
+					cellCount++;
+
+					if (fieldEnd == lineEnd)
+					{
+						break;
+					}
+					fieldStart = fieldEnd + 1;
+				}
+				rowEntries << cellCount;
+				rowCount++;
+			}
+			lineStart = nextLine;
+		}
+		tableEntries << rowCount;
+	}
+
+	const quint32 tableCount = tableEntries.size() / 4;
+	const quint32 rowTableOffset = headerSize + tableEntries.size() * sizeof(quint32);
+	const quint32 cellTableOffset = rowTableOffset + rowEntries.size() * sizeof(quint32);
+	const quint32 poolOffset = cellTableOffset + cellEntries.size() * sizeof(quint32);
+
+	QByteArray snapshot;
+	snapshot.reserve(poolOffset + pool.size());
+	auto writeInt = [&snapshot](quint32 value)
+	{
+		char bytes[sizeof(quint32)];
+		qToLittleEndian(value, bytes);
+		snapshot.append(bytes, sizeof(quint32));
+	};
+
+	for (quint32 value : {magic, version, tableCount, rowTableOffset, cellTableOffset, poolOffset})
+	{
+		writeInt(value);
+	}
+	for (quint32 value : tableEntries)
+	{
+		writeInt(value);
+	}
+	for (quint32 value : rowEntries)
+	{
+		writeInt(value);
+	}
+	for (quint32 value : cellEntries)
+	{
+		writeInt(value);
+	}
+	snapshot.append(pool);
+
+	return snapshot;
+}
+
+quint32 DatabaseSnapshot::readInt(qint64 offset) const
+{
+	return qFromLittleEndian<quint32>(this->data + offset);
+}
+
+/**
+ * This function checks every offset in the snapshot once so lookups never have to
+ */
+bool DatabaseSnapshot::open(const uchar *bytes, qint64 size)
+{
+	this->data = bytes;
+	this->size = size;
+	this->tables.clear();
+
+	auto fail = [this]()
+	{
+		this->data = nullptr;
+		this->size = 0;
+		this->tables.clear();
+		return false;
+	};
+
+	if (size < headerSize || this->readInt(0) != magic || this->readInt(4) != version)
+	{
+		return fail();
+	}
+
+	const quint64 tableCount = this->readInt(8);
+	this->rowTableOffset = this->readInt(12);
+	this->cellTableOffset = this->readInt(16);
+	this->poolOffset = this->readInt(20);
+
+	if (this->rowTableOffset != headerSize + tableCount * tableEntrySize ||
+		this->cellTableOffset < this->rowTableOffset || (this->cellTableOffset - this->rowTableOffset) % pairSize != 0 ||
+		this->poolOffset < this->cellTableOffset || (this->poolOffset - this->cellTableOffset) % pairSize != 0 ||
+		this->poolOffset > quint64(size))
+	{
+		return fail();
+	}
+
+	const quint64 totalRows = (this->cellTableOffset - this->rowTableOffset) / pairSize;
+	const quint64 totalCells = (this->poolOffset - this->cellTableOffset) / pairSize;
+	const quint64 poolSize = size - this->poolOffset;
+
+	for (quint64 i = 0; i < totalCells; i++)
+	{
+		const qint64 entry = this->cellTableOffset + i * pairSize;
+		if (quint64(this->readInt(entry)) + this->readInt(entry + 4) > poolSize)
+		{
+			return fail();
+		}
+	}
+
+	for (quint64 i = 0; i < totalRows; i++)
+	{
+		const qint64 entry = this->rowTableOffset + i * pairSize;
+		if (quint64(this->readInt(entry)) + this->readInt(entry + 4) > totalCells)
+		{
+			return fail();
+		}
+	}
+
+	for (quint64 i = 0; i < tableCount; i++)
+	{
+		const qint64 entry = headerSize + i * tableEntrySize;
+		const quint32 nameOffset = this->readInt(entry);
+		const quint32 nameSize = this->readInt(entry + 4);
+		const TableEntry table{this->readInt(entry + 8), this->readInt(entry + 12)};
+		if (quint64(nameOffset) + nameSize > poolSize || quint64(table.firstRow) + table.rowCount > totalRows)
+		{
+			return fail();
+		}
+
+		const char *name = reinterpret_cast<const char *>(this->data + this->poolOffset + nameOffset);
+		this->tables.insert(QString::fromUtf8(name, nameSize), table);
+	}
+
+	return true;
+}
+
+int DatabaseSnapshot::rowCount(const QString &table) const
+{
+	auto it = this->tables.constFind(table);
+	return it == this->tables.constEnd() ? 0 : it.value().rowCount;
+}
+
+DatabaseSnapshot::Row DatabaseSnapshot::row(const QString &table, int index) const
+{
+	auto it = this->tables.constFind(table);
+	if (it == this->tables.constEnd() || index < 0 || quint32(index) >= it.value().rowCount)
+	{
+		return Row(this, 0, 0);
+	}
+
+	const qint64 entry = this->rowTableOffset + qint64(it.value().firstRow + index) * pairSize;
+	return Row(this, this->readInt(entry), this->readInt(entry + 4));
+}
+
+DatabaseSnapshot::Field DatabaseSnapshot::Row::operator[](int index) const
+{
+	if (index < 0 || index >= this->cellCount)
+	{
+		return Field{"", 0};
+	}
+
+	const qint64 entry = this->snapshot->cellTableOffset + qint64(this->firstCell + index) * pairSize;
+	const quint32 offset = this->snapshot->readInt(entry);
+	const quint32 size = this->snapshot->readInt(entry + 4);
+	return Field{reinterpret_cast<const char *>(this->snapshot->data + this->snapshot->poolOffset + offset), int(size)};
+}
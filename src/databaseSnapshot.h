@@ -0,0 +1,95 @@
+/*
+Name: databaseSnapshot.h
+Description: Versioned binary snapshot of every table in data/databases. The snapshot is
+			 memory-mapped and fields are read straight out of the mapping without copying.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef DATABASESNAPSHOT_H
+#define DATABASESNAPSHOT_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+/*
+Snapshot layout, every integer is a little endian quint32:
+	header		magic, version, tableCount, rowTableOffset, cellTableOffset, poolOffset
+	tables		tableCount x (nameOffset, nameSize, firstRow, rowCount)
+	rows		(firstCell, cellCount) for every row of every table
+	cells		(offset, size) for every field of every row
+	pool		UTF-8 bytes of table names and fields, offsets above are relative to it
+Header lines of the source files are not stored.
+*/
+class DatabaseSnapshot
+{
+public:
+	// A view of one field inside the mapped snapshot, only valid while the snapshot is alive
+	struct Field
+	{
+		const char *data;
+		int size;
+
+		bool isEmpty() const { return this->size == 0; }
+		QString toString() const { return QString::fromUtf8(this->data, this->size); }
+		int toInt() const { return QByteArray::fromRawData(this->data, this->size).toInt(); }
+	};
+
+	class Row
+	{
+	public:
+		int size() const { return this->cellCount; }
+		Field operator[](int index) const;
+
+	private:
+		friend class DatabaseSnapshot;
+		Row(const DatabaseSnapshot *snapshot, quint32 firstCell, int cellCount)
+			: snapshot(snapshot), firstCell(firstCell), cellCount(cellCount) {}
+
+		const DatabaseSnapshot *snapshot;
+		quint32 firstCell;
+		int cellCount;
+	};
+
+	// Maps data/databases/databases.snapshot, rebuilding it first if any table is newer
+	explicit DatabaseSnapshot(const QString &directory);
+
+	bool isValid() const { return this->data != nullptr; }
+
+	// Number of rows in a table, ex. rowCount("Races.tsv"), 0 if the table does not exist
+	int rowCount(const QString &table) const;
+	Row row(const QString &table, int index) const;
+
+	static constexpr quint32 magic = 0x53444E44; // "DNDS"
+	static constexpr quint32 version = 1;
+
+private:
+	DatabaseSnapshot(const DatabaseSnapshot &) = delete;
+	DatabaseSnapshot &operator=(const DatabaseSnapshot &) = delete;
+
+	struct TableEntry
+	{
+		quint32 firstRow;
+		quint32 rowCount;
+	};
+
+	static bool isStale(const QString &directory, const QString &snapshotPath);
+	static QByteArray compile(const QString &directory);
+	bool open(const uchar *bytes, qint64 size);
+	quint32 readInt(qint64 offset) const;
+
+	QFile file; // owns the mapping, it is released when the file is destroyed
+	QByteArray fallback; // used when the snapshot could not be written to disk
+	const uchar *data = nullptr;
+	qint64 size = 0;
+	quint32 rowTableOffset = 0;
+	quint32 cellTableOffset = 0;
+	quint32 poolOffset = 0;
+	QHash<QString, TableEntry> tables;
+};
+
+#endif // DATABASESNAPSHOT_H
@@ -0,0 +1,156 @@
+/*
+Name: directoryStorage.cpp
+Description: Keeps each character's records as files in their folder under data/characters. Every file is
+			 replaced atomically, so a crash mid save leaves the old file instead of a truncated one. Saving
+			 several records replaces them one after another, so it is not atomic as a whole.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "directoryStorage.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+static const QStringList imageExtentions = {"png", "jpg", "bmp", "jpeg"};
+
+QStringList DirectoryStorage::characters() const
+{
+	QStringList names;
+	const QStringList folders =
+		QDir(QDir::currentPath() + "/data/characters").entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+	for (const QString &folder : folders)
+	{
+		// A folder without a character file only holds a portrait
+		if (QFile::exists(characterPath(folder) + "/character.csv"))
+		{
+			names.append(folder);
+		}
+	}
+	return names;
+}
+
+QStringList DirectoryStorage::records(const QString &character) const
+{
+	QStringList names;
+	const QFileInfoList files = QDir(characterPath(character)).entryInfoList(QDir::Files, QDir::Name);
+	for (const QFileInfo &file : files)
+	{
+		// Images are never records, the portrait and any art imported with the character (Aurora exports
+		// charactera1.jpg, characterc.png and others) stay in the folder whatever the storage is
+		if (imageExtentions.contains(file.suffix().toLower()))
+		{
+			continue;
+		}
+		names.append(file.fileName());
+	}
+	return names;
+}
+
+CharacterStorage::RecordInfo DirectoryStorage::info(const QString &character, const QString &record) const
+{
+	QFileInfo file(characterPath(character) + "/" + record);
+	RecordInfo info;
+	info.exists = file.exists();
+	if (info.exists)
+	{
+		info.size = file.size();
+		info.lastModified = file.lastModified().toMSecsSinceEpoch();
+	}
+	return info;
+}
+
+qint64 DirectoryStorage::generation() const
+{
+	QFileInfo folder(QDir::currentPath() + "/data/characters");
+	return folder.exists() ? folder.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+QByteArray DirectoryStorage::read(const QString &character, const QString &record, bool *ok) const
+{
+	QFile file(characterPath(character) + "/" + record);
+	bool opened = file.open(QIODevice::ReadOnly);
+	if (ok)
+	{
+		*ok = opened;
+	}
+	return opened ? file.readAll() : QByteArray();
+}
+
+bool DirectoryStorage::write(const QString &character, const QMap<QString, QByteArray> &records)
+{
+	QString path = characterPath(character);
+	if (!QDir().mkpath(path))
+	{
+		qWarning() << "Could not create character folder" << path;
+		return false;
+	}
+
+	// Nothing replaces an old file until every new one is written, so a failure leaves all of them as they were
+	std::vector<std::unique_ptr<QSaveFile>> files;
+	for (auto it = records.constBegin(); it != records.constEnd(); ++it)
+	{
+		files.emplace_back(new QSaveFile(path + "/" + it.key()));
+		QSaveFile &file = *files.back();
+		if (!file.open(QIODevice::WriteOnly) || file.write(it.value()) != it.value().size())
+		{
+			qWarning() << "Could not write" << file.fileName() << file.errorString();
+			return false; // unique_ptr cancels the writes that were started
+		}
+	}
+
+	// character.csv is what makes a folder a character, so a new character only shows up once the rest is in
+	std::stable_partition(files.begin(), files.end(), [](const std::unique_ptr<QSaveFile> &file) {
+		return QFileInfo(file->fileName()).fileName() != "character.csv";
+	});
+
+	bool committed = true;
+	for (std::unique_ptr<QSaveFile> &file : files)
+	{
+		if (!file->commit())
+		{
+			qWarning() << "Could not save" << file->fileName() << file->errorString();
+			committed = false;
+		}
+	}
+	return committed;
+}
+
+bool DirectoryStorage::append(const QString &character, const QString &record, const QByteArray &data)
+{
+	QString path = characterPath(character);
+	QDir().mkpath(path);
+
+	QFile file(path + "/" + record);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(data) != data.size())
+	{
+		qWarning() << "Could not add to" << file.fileName() << file.errorString();
+		return false;
+	}
+	return file.flush();
+}
+
+bool DirectoryStorage::removeRecord(const QString &character, const QString &record)
+{
+	QFile file(characterPath(character) + "/" + record);
+	if (file.exists() && !file.remove())
+	{
+		qWarning() << "Could not remove" << file.fileName() << file.errorString();
+		return false;
+	}
+	return true;
+}
+
+bool DirectoryStorage::removeCharacter(const QString &character)
+{
+	return QDir(characterPath(character)).removeRecursively();
+}
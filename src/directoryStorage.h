@@ -0,0 +1,37 @@
+/*
+Name: directoryStorage.h
+Description: Keeps each character's records as files in their folder under data/characters. Every file is
+			 replaced atomically, so a crash mid save leaves the old file instead of a truncated one. Saving
+			 several records replaces them one after another, so it is not atomic as a whole.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef DIRECTORYSTORAGE_H
+#define DIRECTORYSTORAGE_H
+
+#include "characterStorage.h"
+
+class DirectoryStorage : public CharacterStorage
+{
+public:
+	Backend backend() const override { return Folders; }
+	QStringList characters() const override;
+	QStringList records(const QString &character) const override;
+	RecordInfo info(const QString &character, const QString &record) const override;
+	// The characters folder's modified time, it changes when a character's folder is added or removed
+	qint64 generation() const override;
+	QByteArray read(const QString &character, const QString &record, bool *ok = nullptr) const override;
+	// Every file is written out before any of them replaces the old one, then they replace them one at a
+	// time with character.csv last. A file that fails to write changes nothing, a crash while replacing can leave some new
+	bool write(const QString &character, const QMap<QString, QByteArray> &records) override;
+	bool append(const QString &character, const QString &record, const QByteArray &data) override;
+	bool removeRecord(const QString &character, const QString &record) override;
+	bool removeCharacter(const QString &character) override;
+
+	using CharacterStorage::write;
+};
+
+#endif // DIRECTORYSTORAGE_H
@@ -0,0 +1,57 @@
+/*
+Name: fuzzyCompleter.cpp
+Description: Completer whose popup lists FuzzyMatcher's best matches for the text typed so far, instead
+			 of QCompleter's own prefix filtering, so a typo or a later word still finds the entry.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "fuzzyCompleter.h"
+
+#include <QAbstractItemView>
+#include <QLineEdit>
+#include <QStringListModel>
+
+FuzzyCompleter::FuzzyCompleter(const QStringList &entries, QObject *parent)
+	: QCompleter(parent), matches(new QStringListModel(this))
+{
+	this->matcher.setEntries(entries);
+	this->setModel(this->matches);
+	// The model already holds only the matches, in order, so the completer must not filter it again
+	this->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+	this->setCaseSensitivity(Qt::CaseInsensitive);
+	this->setMaxVisibleItems(10);
+}
+
+void FuzzyCompleter::attach(QLineEdit *edit)
+{
+	edit->setCompleter(this);
+	connect(edit, SIGNAL(textEdited(QString)), SLOT(updateCompletions(QString)));
+}
+
+QString FuzzyCompleter::bestMatch(const QString &text) const
+{
+	QVector<FuzzyMatcher::Match> best = this->matcher.match(text, 1);
+	return best.isEmpty() ? QString() : this->matcher.entries()[best[0].index];
+}
+
+void FuzzyCompleter::updateCompletions(const QString &text)
+{
+	QStringList names;
+	for (const FuzzyMatcher::Match &match : this->matcher.match(text, this->maxVisibleItems()))
+	{
+		names.append(this->matcher.entries()[match.index]);
+	}
+	this->matches->setStringList(names);
+
+	if (names.isEmpty())
+	{
+		this->popup()->hide();
+	}
+	else
+	{
+		this->complete();
+	}
+}
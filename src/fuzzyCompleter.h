@@ -0,0 +1,41 @@
+/*
+Name: fuzzyCompleter.h
+Description: Completer whose popup lists FuzzyMatcher's best matches for the text typed so far, instead
+			 of QCompleter's own prefix filtering, so a typo or a later word still finds the entry.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef FUZZYCOMPLETER_H
+#define FUZZYCOMPLETER_H
+
+#include <QCompleter>
+
+#include "fuzzyMatcher.h"
+
+class QLineEdit;
+class QStringListModel;
+
+class FuzzyCompleter : public QCompleter
+{
+	Q_OBJECT
+public:
+	explicit FuzzyCompleter(const QStringList &entries, QObject *parent = nullptr);
+
+	// Completes the line edit's text, for an editable QComboBox pass its lineEdit()
+	void attach(QLineEdit *edit);
+
+	// The entry typed text stands for, an entry itself if it was typed out exactly, empty if nothing matches
+	QString bestMatch(const QString &text) const;
+
+private slots:
+	void updateCompletions(const QString &text);
+
+private:
+	FuzzyMatcher matcher;
+	QStringListModel *matches;
+};
+
+#endif // FUZZYCOMPLETER_H
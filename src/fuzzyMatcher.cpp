@@ -0,0 +1,303 @@
+/*
+Name: fuzzyMatcher.cpp
+Description: Ranks a list of names against what the user has typed so far. Exact, prefix, word start,
+			 initials and substring matches come first, then names within a typo or two. A trigram index
+			 keeps each keystroke to the names that share letters with the query, even in large catalogs.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "fuzzyMatcher.h"
+
+#include <QSet>
+#include <algorithm>
+#include <numeric>
+
+void FuzzyMatcher::setEntries(const QStringList &entries)
+{
+	this->names = entries;
+	this->normalized.clear();
+	this->initials.clear();
+	this->trigrams.clear();
+	this->normalized.reserve(entries.size());
+	this->initials.reserve(entries.size());
+
+	for (int i = 0; i < entries.size(); i++)
+	{
+		QString name = normalize(entries[i]);
+		QString letters;
+		for (int at = 0; at < name.size(); at++)
+		{
+			if (name[at] != ' ' && (at == 0 || name[at - 1] == ' '))
+			{
+				letters += name[at];
+			}
+		}
+
+		// Padded so the first letters of every word make trigrams of their own, ex. " ma" for Magic Missile
+		QString padded = " " + name + " ";
+		QSet<quint64> seen;
+		for (int at = 0; at + 3 <= padded.size(); at++)
+		{
+			quint64 key = trigram(padded.constData() + at);
+			if (!seen.contains(key))
+			{
+				seen.insert(key);
+				this->trigrams[key].append(i);
+			}
+		}
+
+		this->normalized.append(name);
+		this->initials.append(letters);
+	}
+	this->hits.fill(0, entries.size());
+}
+
+QVector<FuzzyMatcher::Match> FuzzyMatcher::match(const QString &query, int limit) const
+{
+	QString q = normalize(query);
+	if (q.isEmpty() || limit <= 0)
+	{
+		return {};
+	}
+	int maxTypos = q.size() >= 7 ? 2 : q.size() >= 3 ? 1 : 0;
+
+	QVector<int> candidates;
+	if (q.size() < 3)
+	{
+		// Too short to have a trigram of its own, and checking every name for a letter or two is quick anyway
+		candidates.resize(this->names.size());
+		std::iota(candidates.begin(), candidates.end(), 0);
+	}
+	else
+	{
+		// No trailing space, the last word of the query is usually still being typed
+		QString padded = " " + q;
+		QSet<quint64> keys;
+		for (int at = 0; at + 3 <= padded.size(); at++)
+		{
+			keys.insert(trigram(padded.constData() + at));
+		}
+
+		QVector<int> touched;
+		for (quint64 key : keys)
+		{
+			auto it = this->trigrams.constFind(key);
+			if (it == this->trigrams.constEnd())
+			{
+				continue;
+			}
+			for (int i : it.value())
+			{
+				if (this->hits[i]++ == 0)
+				{
+					touched.append(i);
+				}
+			}
+		}
+
+		// A typo breaks at most three trigrams, so a name has to share the rest of them to be worth scoring
+		int need = qMax(1, int(keys.size()) - 3 * maxTypos);
+		for (int i : touched)
+		{
+			if (this->hits[i] >= need)
+			{
+				candidates.append(i);
+			}
+		}
+		// Initials are not in the trigram index, ex. "mmm" for Mordenkainen's Magnificent Mansion
+		if (q.size() <= 5 && !q.contains(' '))
+		{
+			for (int i = 0; i < this->initials.size(); i++)
+			{
+				if (this->hits[i] < need && this->initials[i].startsWith(q))
+				{
+					candidates.append(i);
+				}
+			}
+		}
+		for (int i : touched)
+		{
+			this->hits[i] = 0;
+		}
+	}
+
+	QVector<Match> matches;
+	for (int i : candidates)
+	{
+		int score = this->score(q, i);
+		if (score > 0)
+		{
+			matches.append({i, score});
+		}
+	}
+
+	auto better = [this](const Match &a, const Match &b) {
+		if (a.score != b.score)
+		{
+			return a.score > b.score;
+		}
+		if (this->normalized[a.index].size() != this->normalized[b.index].size())
+		{
+			return this->normalized[a.index].size() < this->normalized[b.index].size();
+		}
+		return a.index < b.index;
+	};
+	if (matches.size() > limit)
+	{
+		std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), better);
+		matches.resize(limit);
+	}
+	else
+	{
+		std::sort(matches.begin(), matches.end(), better);
+	}
+	return matches;
+}
+
+QString FuzzyMatcher::normalize(const QString &text)
+{
+	QString result;
+	result.reserve(text.size());
+	bool space = true;
+	for (QChar c : text)
+	{
+		if (c == '\'' || c == QChar(0x2019))
+		{
+			continue;
+		}
+		if (c.isLetterOrNumber())
+		{
+			result += c.toLower();
+			space = false;
+		}
+		else if (!space)
+		{
+			result += ' ';
+			space = true;
+		}
+	}
+	if (result.endsWith(' '))
+	{
+		result.chop(1);
+	}
+	return result;
+}
+
+int FuzzyMatcher::score(const QString &query, int index) const
+{
+	const QString &name = this->normalized[index];
+	if (name == query)
+	{
+		return 1000;
+	}
+	if (name.startsWith(query))
+	{
+		return 900 - qMin(int(name.size() - query.size()), 99);
+	}
+	int word = name.indexOf(" " + query);
+	if (word >= 0)
+	{
+		return 800 - qMin(word, 99);
+	}
+
+	if (query.contains(' '))
+	{
+		// Every word of the query starts a word of the name, in any order, ex. "mark hunt"
+		bool allWords = true;
+		for (const QString &part : query.split(' '))
+		{
+			if (!name.startsWith(part) && !name.contains(" " + part))
+			{
+				allWords = false;
+				break;
+			}
+		}
+		if (allWords)
+		{
+			return 700;
+		}
+	}
+	else if (query.size() >= 2 && this->initials[index].startsWith(query))
+	{
+		return 600 - int(this->initials[index].size() - query.size());
+	}
+
+	int at = name.indexOf(query);
+	if (at >= 0)
+	{
+		return 500 - qMin(at, 99);
+	}
+
+	int maxTypos = query.size() >= 7 ? 2 : query.size() >= 3 ? 1 : 0;
+	int typos = maxTypos > 0 ? typoDistance(query, name, maxTypos) : 1;
+	if (typos <= maxTypos)
+	{
+		return 400 - 100 * typos;
+	}
+	return 0;
+}
+
+int FuzzyMatcher::typoDistance(const QString &query, const QString &name, int maxTypos)
+{
+	// Compare the query with the start of every word, allowing for a letter too many or too few
+	int best = maxTypos + 1;
+	for (int start = 0; start < name.size() && best > 0; start++)
+	{
+		if (start > 0 && name[start - 1] != ' ')
+		{
+			continue;
+		}
+		for (int length = qMax(1, int(query.size()) - maxTypos); length <= query.size() + maxTypos; length++)
+		{
+			if (start + length > name.size())
+			{
+				break;
+			}
+			best = qMin(best, editDistance(query, name.mid(start, length), best - 1));
+		}
+	}
+	return best;
+}
+
+int FuzzyMatcher::editDistance(const QString &a, const QString &b, int max)
+{
+	// Optimal string alignment distance, so swapped neighbours like "fierball" count as one typo.
+	// Gives up with max + 1 as soon as every path is already over max
+	if (max < 0 || qAbs(a.size() - b.size()) > max)
+	{
+		return max + 1;
+	}
+
+	QVector<int> before(b.size() + 1), previous(b.size() + 1), current(b.size() + 1);
+	std::iota(previous.begin(), previous.end(), 0);
+	for (int i = 1; i <= a.size(); i++)
+	{
+		current[0] = i;
+		int rowBest = current[0];
+		for (int j = 1; j <= b.size(); j++)
+		{
+			int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+			current[j] = qMin(qMin(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+			if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+			{
+				current[j] = qMin(current[j], before[j - 2] + 1);
+			}
+			rowBest = qMin(rowBest, current[j]);
+		}
+		if (rowBest > max)
+		{
+			return max + 1;
+		}
+		std::swap(before, previous);
+		std::swap(previous, current);
+	}
+	return qMin(previous[b.size()], max + 1);
+}
+
+quint64 FuzzyMatcher::trigram(const QChar *text)
+{
+	return (quint64(text[0].unicode()) << 32) | (quint64(text[1].unicode()) << 16) | text[2].unicode();
+}
@@ -0,0 +1,54 @@
+/*
+Name: fuzzyMatcher.h
+Description: Ranks a list of names against what the user has typed so far. Exact, prefix, word start,
+			 initials and substring matches come first, then names within a typo or two. A trigram index
+			 keeps each keystroke to the names that share letters with the query, even in large catalogs.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class FuzzyMatcher
+{
+public:
+	struct Match
+	{
+		int index; // into entries()
+		int score;
+	};
+
+	void setEntries(const QStringList &entries);
+	const QStringList &entries() const { return this->names; }
+	int size() const { return this->names.size(); }
+
+	// Best matches first, ties go to the shorter name. An empty query matches nothing
+	QVector<Match> match(const QString &query, int limit = 50) const;
+
+	// Lowercase with punctuation dropped and runs of spaces collapsed, ex. "Hunter's Mark" is "hunters mark"
+	static QString normalize(const QString &text);
+
+private:
+	int score(const QString &query, int index) const;
+	static int typoDistance(const QString &query, const QString &name, int maxTypos);
+	static int editDistance(const QString &a, const QString &b, int max);
+	static quint64 trigram(const QChar *text);
+
+	QStringList names;
+	QVector<QString> normalized;
+	QVector<QString> initials; // first letter of every word, ex. "mm" for Magic Missile
+	QHash<quint64, QVector<int>> trigrams; // entries that contain each trigram, in ascending order
+
+	// Reused between keystrokes so a query does not allocate a counter per entry
+	mutable QVector<quint16> hits;
+};
+
+#endif // FUZZYMATCHER_H
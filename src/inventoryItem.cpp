@@ -0,0 +1,39 @@
+/*
+Name: inventoryItem.cpp
+Description: One line of a character's inventory.csv as a plain struct, with the conversion to and from
+			 the comma separated line.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "inventoryItem.h"
+
+#include <QStringList>
+
+InventoryItem InventoryItem::fromLine(const QString &line, bool *ok)
+{
+	InventoryItem item;
+	QStringList fields = line.trimmed().split(",");
+	if (ok)
+	{
+		*ok = fields.size() >= 4;
+	}
+	if (fields.size() < 4)
+	{
+		return item;
+	}
+
+	item.name = fields[0];
+	item.quantity = fields[1].toInt();
+	item.equipped = fields[2].toInt() == 1;
+	item.attuned = fields[3].toInt() == 1;
+	return item;
+}
+
+QString InventoryItem::toLine() const
+{
+	return this->name + "," + QString::number(this->quantity) + "," + (this->equipped ? "1" : "0") + "," +
+		   (this->attuned ? "1" : "0");
+}
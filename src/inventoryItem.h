@@ -0,0 +1,28 @@
+/*
+Name: inventoryItem.h
+Description: One line of a character's inventory.csv as a plain struct, with the conversion to and from
+			 the comma separated line.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef INVENTORYITEM_H
+#define INVENTORYITEM_H
+
+#include <QString>
+
+struct InventoryItem
+{
+	QString name;
+	int quantity = 1;
+	bool equipped = false;
+	bool attuned = false;
+
+	// Reads name,quantity,equipped,attuned
+	static InventoryItem fromLine(const QString &line, bool *ok = nullptr);
+	QString toLine() const;
+};
+
+#endif // INVENTORYITEM_H
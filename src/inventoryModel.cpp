@@ -0,0 +1,215 @@
+/*
+Name: inventoryModel.cpp
+Description: List model over a character's inventory, one row per InventoryItem. Changing an item only
+			 reports that row as changed, so the view repaints one line instead of being rebuilt, and the
+			 carried weight is adjusted by that row's difference instead of being summed again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "inventoryModel.h"
+#include "referenceDatabase.h"
+
+#include <QDebug>
+
+InventoryModel::InventoryModel(QObject *parent)
+	: QAbstractListModel(parent)
+{
+}
+
+void InventoryModel::setLines(const QStringList &lines)
+{
+	const ItemCompendium &compendium = ReferenceDatabase::instance().itemCompendium();
+	QVector<InventoryItem> items;
+	QVector<int> weights;
+	items.reserve(lines.size());
+	weights.reserve(lines.size());
+	int attunedItems = 0;
+	qint64 carriedWeight = 0;
+	for (const QString &line : lines)
+	{
+		bool ok = false;
+		InventoryItem item = InventoryItem::fromLine(line, &ok);
+		if (!ok)
+		{
+			qWarning() << "Invalid inventory line:" << line;
+			continue; // Skip invalid lines
+		}
+		int weight = compendium.weight(item.name);
+		attunedItems += item.attuned ? 1 : 0;
+		carriedWeight += qint64(weight) * item.quantity;
+		items.append(item);
+		weights.append(weight);
+	}
+
+	this->beginResetModel();
+	this->rows = items;
+	this->unitWeights = weights;
+	this->attuned = attunedItems;
+	this->endResetModel();
+	this->addCarried(carriedWeight - this->carried);
+}
+
+QStringList InventoryModel::toLines() const
+{
+	QStringList lines;
+	lines.reserve(this->rows.size());
+	for (const InventoryItem &item : this->rows)
+	{
+		lines.append(item.toLine());
+	}
+	return lines;
+}
+
+void InventoryModel::addItem(const InventoryItem &item)
+{
+	int row = this->rows.size();
+	int weight = ReferenceDatabase::instance().itemCompendium().weight(item.name);
+	this->beginInsertRows(QModelIndex(), row, row);
+	this->rows.append(item);
+	this->unitWeights.append(weight);
+	this->attuned += item.attuned ? 1 : 0;
+	this->endInsertRows();
+	this->addCarried(qint64(weight) * item.quantity);
+	if (item.equipped)
+	{
+		emit itemEquipped(item.name, true);
+	}
+	emit edited();
+}
+
+void InventoryModel::removeItem(int row)
+{
+	if (row < 0 || row >= this->rows.size())
+	{
+		return;
+	}
+	InventoryItem removed = this->rows[row];
+	qint64 weight = qint64(this->unitWeights[row]) * removed.quantity;
+	this->beginRemoveRows(QModelIndex(), row, row);
+	this->attuned -= removed.attuned ? 1 : 0;
+	this->rows.remove(row);
+	this->unitWeights.remove(row);
+	this->endRemoveRows();
+	this->addCarried(-weight);
+	if (removed.equipped)
+	{
+		emit itemEquipped(removed.name, false);
+	}
+	emit edited();
+}
+
+void InventoryModel::setQuantity(int row, int quantity)
+{
+	if (row < 0 || row >= this->rows.size() || quantity < 1 || this->rows[row].quantity == quantity)
+	{
+		return;
+	}
+	InventoryItem item = this->rows[row];
+	item.quantity = quantity;
+	this->replaceRow(row, item);
+}
+
+void InventoryModel::setEquipped(int row, bool equipped)
+{
+	if (row < 0 || row >= this->rows.size() || this->rows[row].equipped == equipped)
+	{
+		return;
+	}
+	InventoryItem item = this->rows[row];
+	item.equipped = equipped;
+	item.attuned = item.attuned && equipped;
+	this->replaceRow(row, item);
+}
+
+bool InventoryModel::setAttuned(int row, bool attuned)
+{
+	if (row < 0 || row >= this->rows.size())
+	{
+		return false;
+	}
+	if (this->rows[row].attuned == attuned)
+	{
+		return true;
+	}
+	if (attuned && (!this->rows[row].equipped || this->attuned >= maxAttuned))
+	{
+		return false;
+	}
+	InventoryItem item = this->rows[row];
+	item.attuned = attuned;
+	this->replaceRow(row, item);
+	return true;
+}
+
+void InventoryModel::replaceRow(int row, const InventoryItem &item)
+{
+	this->attuned += (item.attuned ? 1 : 0) - (this->rows[row].attuned ? 1 : 0);
+	qint64 weightChange = qint64(this->unitWeights[row]) * (item.quantity - this->rows[row].quantity);
+	bool equipChanged = item.equipped != this->rows[row].equipped;
+	this->rows[row] = item;
+	QModelIndex changed = this->index(row);
+	emit dataChanged(changed, changed);
+	this->addCarried(weightChange);
+	if (equipChanged)
+	{
+		emit itemEquipped(item.name, item.equipped);
+	}
+	emit edited();
+}
+
+void InventoryModel::addCarried(qint64 change)
+{
+	if (change == 0)
+	{
+		return;
+	}
+	this->carried += change;
+	emit carriedWeightChanged(this->carriedWeight());
+}
+
+int InventoryModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : this->rows.size();
+}
+
+QVariant InventoryModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= this->rows.size())
+	{
+		return QVariant();
+	}
+
+	const InventoryItem &item = this->rows[index.row()];
+	switch (role)
+	{
+	case Qt::DisplayRole:
+	{
+		QString text = "(" + QString::number(item.quantity) + ") " + item.name;
+		if (item.equipped && item.attuned)
+		{
+			text += " [Equipped & Attuned]";
+		}
+		else if (item.attuned)
+		{
+			text += " [Attuned]";
+		}
+		else if (item.equipped)
+		{
+			text += " [Equipped]";
+		}
+		return text;
+	}
+	case NameRole:
+		return item.name;
+	case QuantityRole:
+		return item.quantity;
+	case EquippedRole:
+		return item.equipped;
+	case AttunedRole:
+		return item.attuned;
+	}
+	return QVariant();
+}
@@ -0,0 +1,75 @@
+/*
+Name: inventoryModel.h
+Description: List model over a character's inventory, one row per InventoryItem. Changing an item only
+			 reports that row as changed, so the view repaints one line instead of being rebuilt, and the
+			 carried weight is adjusted by that row's difference instead of being summed again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef INVENTORYMODEL_H
+#define INVENTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QVector>
+
+#include "inventoryItem.h"
+
+class InventoryModel : public QAbstractListModel
+{
+	Q_OBJECT
+public:
+	enum Role
+	{
+		NameRole = Qt::UserRole + 1,
+		QuantityRole,
+		EquippedRole,
+		AttunedRole
+	};
+
+	static constexpr int maxAttuned = 3;
+
+	explicit InventoryModel(QObject *parent = nullptr);
+
+	// Reads and writes the lines of inventory.csv, lines that are not items are skipped
+	void setLines(const QStringList &lines);
+	QStringList toLines() const;
+
+	const QVector<InventoryItem> &items() const { return this->rows; }
+	const InventoryItem &item(int row) const { return this->rows[row]; }
+
+	void addItem(const InventoryItem &item);
+	void removeItem(int row);
+	void setQuantity(int row, int quantity);
+	// Unequipping an item also ends its attunement
+	void setEquipped(int row, bool equipped);
+	// False if the item is not equipped or maxAttuned items are already attuned
+	bool setAttuned(int row, bool attuned);
+	int attunedCount() const { return this->attuned; }
+	// Total weight in pounds of the items found in Items.tsv
+	double carriedWeight() const { return this->carried / 1000.0; }
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+signals:
+	// Sent after every change to the items, but not when setLines replaces them
+	void edited();
+	void carriedWeightChanged(double pounds);
+	// Sent for each item that is equipped or unequipped, including when an equipped item is added or removed
+	void itemEquipped(const QString &name, bool equipped);
+
+private:
+	void replaceRow(int row, const InventoryItem &item);
+	void addCarried(qint64 change);
+
+	QVector<InventoryItem> rows;
+	QVector<int> unitWeights; // weight of one of each row's item from Items.tsv, in thousandths of a pound
+	int attuned = 0; // kept up to date so attuning does not have to count every item
+	qint64 carried = 0; // thousandths of a pound, kept up to date the same way
+};
+
+#endif // INVENTORYMODEL_H
@@ -0,0 +1,91 @@
+/*
+Name: itemCompendium.cpp
+Description: Every item in Items.tsv held in memory with a hash index on the name, so the add item dialogs
+			 can complete names and the inventory can look up an item's weight without scanning the table.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "itemCompendium.h"
+#include "databaseSnapshot.h"
+
+#include <QDebug>
+
+void ItemCompendium::load(const DatabaseSnapshot &snapshot)
+{
+	for (int i = 0; i < snapshot.rowCount("Items.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = snapshot.row("Items.tsv", i);
+		if (fields.size() < 9)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		ItemInfo item;
+		item.name = fields[0].toString();
+		item.type = fields[1].toString();
+		item.book = fields[2].toString();
+		item.page = fields[3].toString();
+		item.cost = fields[4].toString();
+		item.weight = qRound(fields[5].toString().toDouble() * 1000);
+		item.damage = fields[6].toString();
+		item.properties = fields[7].toString();
+		item.armorClass = fields[8].toInt();
+
+		QString key = item.name.toLower();
+		if (this->nameIndex.contains(key))
+		{
+			qWarning() << "Items.tsv has" << item.name << "more than once, keeping the first";
+			continue;
+		}
+
+		this->nameIndex.insert(key, this->entries.size());
+		this->allNames.append(item.name);
+		if (!this->typeNames.contains(item.type))
+		{
+			this->typeOrder.append(item.type);
+		}
+		this->typeNames[item.type].append(item.name);
+		this->entries.append(item);
+	}
+}
+
+int ItemCompendium::find(const QString &name) const
+{
+	QString key = name.trimmed().toLower();
+	auto it = this->nameIndex.constFind(key);
+	if (it != this->nameIndex.constEnd())
+	{
+		return it.value();
+	}
+
+	// Starting equipment is written as "2 Handaxes" or "20 Arrows"
+	if (key.endsWith("es"))
+	{
+		it = this->nameIndex.constFind(key.chopped(2));
+		if (it != this->nameIndex.constEnd())
+		{
+			return it.value();
+		}
+	}
+	if (key.endsWith("s"))
+	{
+		return this->nameIndex.value(key.chopped(1), -1);
+	}
+	return -1;
+}
+
+int ItemCompendium::weight(const QString &name) const
+{
+	int id = this->find(name);
+	return id < 0 ? 0 : this->entries[id].weight;
+}
+
+const QStringList &ItemCompendium::names(const QString &type) const
+{
+	static const QStringList none;
+	auto it = this->typeNames.constFind(type);
+	return it == this->typeNames.constEnd() ? none : it.value();
+}
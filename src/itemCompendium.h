@@ -0,0 +1,64 @@
+/*
+Name: itemCompendium.h
+Description: Every item in Items.tsv held in memory with a hash index on the name, so the add item dialogs
+			 can complete names and the inventory can look up an item's weight without scanning the table.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef ITEMCOMPENDIUM_H
+#define ITEMCOMPENDIUM_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class DatabaseSnapshot;
+
+struct ItemInfo
+{
+	QString name;
+	QString type;
+	QString book;
+	QString page;
+	QString cost;
+	int weight = 0; // thousandths of a pound, so adding up an inventory stays exact
+	QString damage;
+	QString properties;
+	int armorClass = 0; // base AC of armor, the bonus of a shield, 0 for anything else
+
+	bool isArmor() const { return this->type.endsWith(" Armor"); }
+	bool isShield() const { return this->type == "Shield"; }
+};
+
+class ItemCompendium
+{
+public:
+	void load(const DatabaseSnapshot &snapshot);
+
+	// Items are numbered in the order of Items.tsv
+	int size() const { return this->entries.size(); }
+	const ItemInfo &item(int id) const { return this->entries[id]; }
+	// Case-insensitive and also tries the name without a plural s, -1 if the item is not in Items.tsv
+	int find(const QString &name) const;
+	// Weight of one of the item in thousandths of a pound, 0 for items not in Items.tsv
+	int weight(const QString &name) const;
+
+	// Item names in table order, all of them or only those of one type such as "Simple Melee Weapon"
+	const QStringList &names() const { return this->allNames; }
+	const QStringList &names(const QString &type) const;
+	// Types in the order they first appear
+	const QStringList &types() const { return this->typeOrder; }
+
+private:
+	QVector<ItemInfo> entries;
+	QHash<QString, int> nameIndex; // lowercase name to id
+	QStringList allNames;
+	QStringList typeOrder;
+	QHash<QString, QStringList> typeNames; // type to item names
+};
+
+#endif // ITEMCOMPENDIUM_H
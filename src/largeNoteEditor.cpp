@@ -0,0 +1,167 @@
+/*
+Name: largeNoteEditor.cpp
+Description: Plain text editor for notes that stays responsive on multi-megabyte sections. Only the visible
+			 blocks are laid out, huge sections are loaded a chunk at a time, and the span of text changed
+			 since the last save is tracked so saving never copies the whole note.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "largeNoteEditor.h"
+
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QTimer>
+
+// Sections up to this many characters are loaded at once, larger ones a chunk of it per event loop pass
+static const int loadChunk = 256 * 1024;
+
+LargeNoteEditor::LargeNoteEditor(QWidget *parent)
+	: QPlainTextEdit(parent)
+{
+	connect(this->document(), &QTextDocument::contentsChange, this, &LargeNoteEditor::recordChange);
+}
+
+void LargeNoteEditor::loadText(const QString &text)
+{
+	// The loaded text is not something to undo back through
+	this->generation++;
+	this->loading = true;
+	this->selectOffset = -1;
+	this->setUndoRedoEnabled(false);
+	this->setReadOnly(true);
+
+	if (text.size() <= loadChunk)
+	{
+		this->setPlainText(text);
+		this->finishLoading();
+		return;
+	}
+
+	this->pending = text;
+	this->pendingAt = 0;
+	this->clear();
+	this->loadNextChunk(this->generation);
+}
+
+void LargeNoteEditor::selectRange(int offset, int length)
+{
+	if (this->loading)
+	{
+		this->selectOffset = offset;
+		this->selectLength = length;
+		return;
+	}
+
+	int end = this->document()->characterCount() - 1;
+	QTextCursor cursor = this->textCursor();
+	cursor.setPosition(qBound(0, offset, end));
+	cursor.setPosition(qBound(0, offset + length, end), QTextCursor::KeepAnchor);
+	this->setTextCursor(cursor);
+	this->ensureCursorVisible();
+}
+
+LargeNoteEditor::Change LargeNoteEditor::takeChange()
+{
+	Change change;
+	if (!this->changed)
+	{
+		return change;
+	}
+
+	// contentsChange counts the document's closing block separator, which is not part of the text. A span
+	// reaching it is cut back by the same amount in the old and new text, that separator is in both
+	int end = this->document()->characterCount() - 1;
+	if (this->changeNewEnd > end)
+	{
+		int past = this->changeNewEnd - end;
+		this->changeNewEnd = end;
+		this->changeOldEnd = qMax(0, this->changeOldEnd - past);
+	}
+	this->changeStart = qMin(this->changeStart, this->changeNewEnd);
+	this->changeOldEnd = qMax(this->changeStart, this->changeOldEnd);
+
+	// Only the changed span is copied out of the document
+	QTextCursor cursor(this->document());
+	cursor.setPosition(this->changeStart);
+	cursor.setPosition(this->changeNewEnd, QTextCursor::KeepAnchor);
+	change.at = this->changeStart;
+	change.removed = this->changeOldEnd - this->changeStart;
+	change.insert = cursor.selectedText().replace(QChar::ParagraphSeparator, '\n');
+	this->changed = false;
+	return change;
+}
+
+/**
+ * This function widens the changed span to cover an edit, positions are in the current text so
+ * anything past the span is shifted back by what the span grew to find where it was in the saved text
+ */
+void LargeNoteEditor::recordChange(int position, int charsRemoved, int charsAdded)
+{
+	if (this->loading)
+	{
+		return;
+	}
+
+	int removedEnd = position + charsRemoved;
+	if (!this->changed)
+	{
+		this->changed = true;
+		this->changeStart = position;
+		this->changeOldEnd = removedEnd;
+		this->changeNewEnd = position + charsAdded;
+		return;
+	}
+
+	this->changeStart = qMin(this->changeStart, position);
+	this->changeOldEnd += qMax(0, removedEnd - this->changeNewEnd);
+	this->changeNewEnd = qMax(this->changeNewEnd, removedEnd) + charsAdded - charsRemoved;
+}
+
+void LargeNoteEditor::loadNextChunk(int generation)
+{
+	// A newer load replaced this one
+	if (generation != this->generation)
+	{
+		return;
+	}
+
+	// A chunk never ends half way through a character made of two UTF-16 units
+	int size = qMin(loadChunk, int(this->pending.size()) - this->pendingAt);
+	if (this->pendingAt + size < this->pending.size() && this->pending.at(this->pendingAt + size - 1).isHighSurrogate())
+	{
+		size--;
+	}
+
+	QTextCursor cursor(this->document());
+	cursor.movePosition(QTextCursor::End);
+	cursor.insertText(this->pending.mid(this->pendingAt, size));
+	this->pendingAt += size;
+
+	if (this->pendingAt < this->pending.size())
+	{
+		QTimer::singleShot(0, this, [this, generation]() { this->loadNextChunk(generation); });
+		return;
+	}
+
+	this->pending.clear();
+	this->finishLoading();
+}
+
+void LargeNoteEditor::finishLoading()
+{
+	this->loading = false;
+	this->changed = false;
+	this->setReadOnly(false);
+	this->setUndoRedoEnabled(true);
+	this->moveCursor(QTextCursor::Start);
+
+	if (this->selectOffset >= 0)
+	{
+		this->selectRange(this->selectOffset, this->selectLength);
+		this->selectOffset = -1;
+	}
+	emit loaded();
+}
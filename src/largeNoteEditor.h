@@ -0,0 +1,66 @@
+/*
+Name: largeNoteEditor.h
+Description: Plain text editor for notes that stays responsive on multi-megabyte sections. Only the visible
+			 blocks are laid out, huge sections are loaded a chunk at a time, and the span of text changed
+			 since the last save is tracked so saving never copies the whole note.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef LARGENOTEEDITOR_H
+#define LARGENOTEEDITOR_H
+
+#include <QPlainTextEdit>
+#include <QString>
+
+class LargeNoteEditor : public QPlainTextEdit
+{
+	Q_OBJECT
+public:
+	// The text between at and at + removed in the last saved note, replaced by insert
+	struct Change
+	{
+		int at = 0;
+		int removed = 0;
+		QString insert;
+	};
+
+	explicit LargeNoteEditor(QWidget *parent = nullptr);
+
+	// Replaces the text without it counting as an edit, sections larger than a chunk are added over
+	// several event loop passes and loaded() is emitted once the whole text is in
+	void loadText(const QString &text);
+	bool isLoading() const { return this->loading; }
+
+	// Selects length characters from offset, waiting for the text to finish loading if it has not
+	void selectRange(int offset, int length);
+
+	bool hasChange() const { return this->changed; }
+	// Returns the changed span and starts tracking again from the current text
+	Change takeChange();
+
+signals:
+	void loaded();
+
+private:
+	void recordChange(int position, int charsRemoved, int charsAdded);
+	void loadNextChunk(int generation);
+	void finishLoading();
+
+	QString pending;	 // text still to be added by the chunked load
+	int pendingAt = 0;	 // how much of pending is in the document
+	int generation = 0;	 // bumped by every load so a replaced load stops adding chunks
+	bool loading = false;
+	int selectOffset = -1;
+	int selectLength = 0;
+
+	// Changed span since the last save, start is the same in the saved and current text
+	bool changed = false;
+	int changeStart = 0;
+	int changeOldEnd = 0;
+	int changeNewEnd = 0;
+};
+
+#endif // LARGENOTEEDITOR_H
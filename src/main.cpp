@@ -4,7 +4,7 @@ Description: Main entry point for the application, initializes the GUI and sets
 Authors: Carson Treece, Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 10/20/2024
-Last Modified: 11/24/2024
+Last Modified: 10/17/2026
 */
 
 
@@ -17,6 +17,7 @@ Last Modified: 11/24/2024
 #include "characterSelect.h"
 #include "addCharacter.h"
 #include "settings.h"
+#include "searchNotes.h"
 #include "themeUtils.h"
 
 
@@ -33,6 +34,7 @@ int main(int argc, char ** argv) {
 	AddCharacter * addCharacter = new AddCharacter();
 	QStackedWidget * characterInformation = new QStackedWidget();
 	Settings * settings = new Settings();
+	SearchNotes * searchNotes = new SearchNotes();
 	
 
 	// Add pages to the stacked widget
@@ -40,6 +42,7 @@ int main(int argc, char ** argv) {
 	stackedWidget->addWidget(addCharacter);
 	stackedWidget->addWidget(characterInformation);
 	stackedWidget->addWidget(settings);
+	stackedWidget->addWidget(searchNotes);
 
 	qDebug() << "Widgets in QStackedWidget:";
     for (int i = 0; i < stackedWidget->count(); ++i) {
@@ -62,6 +65,7 @@ int main(int argc, char ** argv) {
 	reloadTheme();
 
 	addCharacter->connect(addCharacter, SIGNAL(createdCharacter()), characterSelect, SLOT(loadCharacterList()));
+	QObject::connect(searchNotes, &SearchNotes::openNote, characterSelect, &CharacterSelect::openNote);
 
 	// Runs the app
 	return app.exec();
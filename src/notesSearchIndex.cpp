@@ -0,0 +1,551 @@
+/*
+Name: notesSearchIndex.cpp
+Description: Persistent inverted index of every character's notes, one file per character under
+			 data/cache/notesSearch. Each word maps to the note sections it appears in and where, so searching
+			 the whole party's notes never opens a note. Kept current by NotesStore as notes are edited, created
+			 and removed, and only the files of characters whose notes changed are written again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "notesSearchIndex.h"
+#include "characterStorage.h"
+#include "notesStore.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QUrl>
+#include <QtMath>
+#include <algorithm>
+#include <iterator>
+
+// Saves are held back this long so a burst of edits writes the index once
+static const int saveDelay = 500;
+
+// Separates the character from the section in a section key, it cannot appear in a character's name
+static const QChar keySeparator(0x1F);
+
+static QDataStream &operator<<(QDataStream &out, const NotesSearchIndex::Posting &posting)
+{
+	out << posting.position << posting.offset;
+	return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, NotesSearchIndex::Posting &posting)
+{
+	in >> posting.position >> posting.offset;
+	return in;
+}
+
+NotesSearchIndex &NotesSearchIndex::instance()
+{
+	static NotesSearchIndex index;
+	return index;
+}
+
+NotesSearchIndex::NotesSearchIndex()
+{
+	this->saveTimer.setSingleShot(true);
+	this->saveTimer.setInterval(saveDelay);
+	connect(&this->saveTimer, &QTimer::timeout, this, &NotesSearchIndex::save);
+	if (qApp)
+	{
+		connect(qApp, &QCoreApplication::aboutToQuit, this, &NotesSearchIndex::flush);
+	}
+
+	// Building reads every note, so a missing index waits until someone searches
+	if (!this->load())
+	{
+		this->incomplete = true;
+	}
+}
+
+void NotesSearchIndex::prepare()
+{
+	// A missing index is still built on the first search, that reads every note
+	if (!this->incomplete && !this->checked)
+	{
+		this->catchUp();
+	}
+}
+
+NotesSearchIndex::~NotesSearchIndex()
+{
+	this->flush();
+}
+
+QString NotesSearchIndex::indexPath()
+{
+	return QDir::currentPath() + "/data/cache/notesSearch";
+}
+
+QString NotesSearchIndex::segmentPath(const QString &character)
+{
+	// Names are stored inside the file, the file name only has to be one the file system accepts
+	return indexPath() + "/" + QString::fromLatin1(QUrl::toPercentEncoding(character)) + ".index";
+}
+
+QString NotesSearchIndex::documentKey(const QString &character, const QString &section)
+{
+	return character + keySeparator + section;
+}
+
+/**
+ * This function splits text into lower case words of letters and numbers, keeping where each one starts
+ */
+QVector<NotesSearchIndex::Token> NotesSearchIndex::tokenize(const QString &text)
+{
+	QVector<Token> tokens;
+	int start = -1;
+	for (int i = 0; i <= text.size(); i++)
+	{
+		bool wordCharacter = i < text.size() && text[i].isLetterOrNumber();
+		if (wordCharacter && start < 0)
+		{
+			start = i;
+		}
+		else if (!wordCharacter && start >= 0)
+		{
+			Token token;
+			token.word = text.mid(start, i - start).toLower();
+			token.posting.position = tokens.size();
+			token.posting.offset = start;
+			tokens.append(token);
+			start = -1;
+		}
+	}
+	return tokens;
+}
+
+QList<NotesSearchIndex::Result> NotesSearchIndex::search(const QString &query, int limit)
+{
+	if (this->incomplete)
+	{
+		this->rebuild();
+	}
+
+	QList<Result> results;
+	const QVector<Token> terms = tokenize(query);
+	if (terms.isEmpty())
+	{
+		return results;
+	}
+
+	// For every word of the query, the sections holding it and where, with the length of the word found
+	struct Occurrence
+	{
+		Posting posting;
+		int length;
+	};
+	QVector<QHash<QString, QVector<Occurrence>>> matches(terms.size());
+	for (int i = 0; i < terms.size(); i++)
+	{
+		const QString &word = terms[i].word;
+		auto begin = this->postings.constFind(word);
+		auto end = begin == this->postings.constEnd() ? begin : std::next(begin);
+		if (i == terms.size() - 1)
+		{
+			// The last word may still be being typed
+			begin = this->postings.lowerBound(word);
+			end = begin;
+			while (end != this->postings.constEnd() && end.key().startsWith(word))
+			{
+				++end;
+			}
+		}
+
+		for (auto it = begin; it != end; ++it)
+		{
+			for (auto document = it.value().constBegin(); document != it.value().constEnd(); ++document)
+			{
+				QVector<Occurrence> &found = matches[i][document.key()];
+				for (const Posting &posting : document.value())
+				{
+					found.append(Occurrence{posting, int(it.key().size())});
+				}
+			}
+		}
+		if (matches[i].isEmpty())
+		{
+			return results; // Every word has to be found
+		}
+	}
+
+	// Start from the word found in the fewest sections, only sections holding all of them are kept
+	int rarest = 0;
+	for (int i = 1; i < matches.size(); i++)
+	{
+		if (matches[i].size() < matches[rarest].size())
+		{
+			rarest = i;
+		}
+	}
+
+	double documentCount = this->documents.isEmpty() ? 1 : this->documents.size();
+	for (auto candidate = matches[rarest].constBegin(); candidate != matches[rarest].constEnd(); ++candidate)
+	{
+		const QString &key = candidate.key();
+		double score = 0;
+		bool all = true;
+		for (int i = 0; i < matches.size() && all; i++)
+		{
+			auto found = matches[i].constFind(key);
+			if (found == matches[i].constEnd())
+			{
+				all = false;
+				break;
+			}
+			// Rare words and words used often in a section count the most
+			double idf = qLn(1.0 + documentCount / matches[i].size());
+			score += (1.0 + qLn(found.value().size())) * idf;
+		}
+		if (!all)
+		{
+			continue;
+		}
+
+		Result result;
+		int split = key.indexOf(keySeparator);
+		result.character = key.left(split);
+		result.section = key.mid(split + 1);
+		const QVector<Occurrence> first = matches[0].value(key);
+		result.offset = first.first().posting.offset;
+		result.length = first.first().length;
+
+		// Look for the words one after another, the first such place is what the result opens to
+		if (matches.size() > 1)
+		{
+			QVector<QHash<qint32, Occurrence>> byPosition(matches.size());
+			for (int i = 1; i < matches.size(); i++)
+			{
+				for (const Occurrence &occurrence : matches[i].value(key))
+				{
+					byPosition[i].insert(occurrence.posting.position, occurrence);
+				}
+			}
+			for (const Occurrence &start : first)
+			{
+				bool phrase = true;
+				Occurrence last = start;
+				for (int i = 1; i < matches.size() && phrase; i++)
+				{
+					auto next = byPosition[i].constFind(start.posting.position + i);
+					phrase = next != byPosition[i].constEnd();
+					if (phrase)
+					{
+						last = next.value();
+					}
+				}
+				if (phrase)
+				{
+					score *= 2;
+					result.offset = start.posting.offset;
+					result.length = last.posting.offset + last.length - start.posting.offset;
+					break;
+				}
+			}
+		}
+
+		result.score = score;
+		results.append(result);
+	}
+
+	std::sort(results.begin(), results.end(), [](const Result &a, const Result &b) {
+		if (a.score != b.score)
+		{
+			return a.score > b.score;
+		}
+		if (a.character != b.character)
+		{
+			return a.character < b.character;
+		}
+		return a.section < b.section;
+	});
+	if (limit > 0 && results.size() > limit)
+	{
+		results.erase(results.begin() + limit, results.end());
+	}
+	return results;
+}
+
+void NotesSearchIndex::updateSection(const QString &character, const QString &section, const QString &text)
+{
+	QString key = documentKey(character, section);
+	this->removeDocument(key);
+
+	QStringList words;
+	for (const Token &token : tokenize(text))
+	{
+		QVector<Posting> &found = this->postings[token.word][key];
+		if (found.isEmpty())
+		{
+			words.append(token.word);
+		}
+		found.append(token.posting);
+	}
+	this->documents.insert(key, words);
+	this->scheduleSave(character);
+}
+
+void NotesSearchIndex::removeSection(const QString &character, const QString &section)
+{
+	this->removeDocument(documentKey(character, section));
+	this->scheduleSave(character);
+}
+
+void NotesSearchIndex::removeCharacter(const QString &character)
+{
+	QString prefix = character + keySeparator;
+	for (const QString &key : this->documents.keys())
+	{
+		if (key.startsWith(prefix))
+		{
+			this->removeDocument(key);
+		}
+	}
+	this->sequences.remove(character);
+	this->scheduleSave(character);
+}
+
+void NotesSearchIndex::setSequence(const QString &character, qint64 sequence)
+{
+	qint64 &current = this->sequences[character];
+	if (current != sequence)
+	{
+		current = sequence;
+		this->scheduleSave(character);
+	}
+}
+
+void NotesSearchIndex::flush()
+{
+	if (this->saveTimer.isActive())
+	{
+		this->saveTimer.stop();
+		this->save();
+	}
+}
+
+bool NotesSearchIndex::load()
+{
+	// The whole party used to be kept in one file that was written again on every save
+	QFile::remove(QDir::currentPath() + "/data/cache/notesSearch.index");
+
+	QDir folder(indexPath());
+	if (!folder.exists())
+	{
+		return false;
+	}
+
+	this->postings.clear();
+	this->documents.clear();
+	this->sequences.clear();
+	for (const QString &name : folder.entryList({"*.index"}, QDir::Files))
+	{
+		QString path = folder.filePath(name);
+		if (!this->loadSegment(path))
+		{
+			// Without its file the character's sequence is unknown, so the next check indexes them again
+			QFile::remove(path);
+		}
+	}
+	return true;
+}
+
+bool NotesSearchIndex::loadSegment(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return false;
+	}
+
+	QDataStream in(&file);
+	quint32 fileMagic = 0;
+	quint32 fileVersion = 0;
+	in >> fileMagic >> fileVersion;
+	if (fileMagic != magic || fileVersion != version)
+	{
+		qDebug() << "Notes search index" << path << "is from a different version, indexing it again";
+		return false;
+	}
+
+	QString character;
+	qint64 sequence = 0;
+	// section -> word -> places it appears
+	QHash<QString, QHash<QString, QVector<Posting>>> sections;
+	in >> character >> sequence >> sections;
+	if (in.status() != QDataStream::Ok || character.isEmpty())
+	{
+		qWarning() << "Notes search index" << path << "is corrupt, indexing it again";
+		return false;
+	}
+
+	this->sequences.insert(character, sequence);
+	for (auto section = sections.constBegin(); section != sections.constEnd(); ++section)
+	{
+		QString key = documentKey(character, section.key());
+		QStringList &words = this->documents[key];
+		for (auto word = section.value().constBegin(); word != section.value().constEnd(); ++word)
+		{
+			this->postings[word.key()].insert(key, word.value());
+			words.append(word.key());
+		}
+	}
+	return true;
+}
+
+void NotesSearchIndex::rebuild()
+{
+	this->postings.clear();
+	this->documents.clear();
+	this->sequences.clear();
+	QDir(indexPath()).removeRecursively();
+
+	const QStringList characters = CharacterStorage::instance().characters();
+	for (const QString &character : characters)
+	{
+		this->indexCharacter(character);
+	}
+
+	this->incomplete = false;
+	this->checked = true;
+	this->saveTimer.stop();
+	this->save();
+	qDebug() << "Notes search index built for" << characters.size() << "characters";
+}
+
+/**
+ * This function indexes again the characters whose notes were saved past the edit the index holds. That happens
+ * when the app stops after the notes were written but before the index was, which on its own looks up to date
+ */
+void NotesSearchIndex::catchUp()
+{
+	this->checked = true;
+	int caught = 0;
+	for (const QString &character : CharacterStorage::instance().characters())
+	{
+		if (NotesStore::lastSavedEdit(character) > this->sequences.value(character, 0))
+		{
+			this->indexCharacter(character);
+			caught++;
+		}
+	}
+	if (caught > 0)
+	{
+		qDebug() << "Notes search index caught up on" << caught << "characters";
+	}
+}
+
+void NotesSearchIndex::indexCharacter(const QString &character)
+{
+	this->removeCharacter(character);
+	NotesStore notes(character);
+	if (!notes.load())
+	{
+		return;
+	}
+	for (const QString &section : notes.sections())
+	{
+		this->updateSection(character, section, notes.text(section));
+	}
+	this->setSequence(character, notes.lastEdit());
+}
+
+void NotesSearchIndex::save()
+{
+	// A partial index on disk would be taken for a whole one next time
+	if (this->incomplete)
+	{
+		return;
+	}
+
+	QDir().mkpath(indexPath());
+	for (const QString &character : this->changed)
+	{
+		this->saveSegment(character);
+	}
+	this->changed.clear();
+}
+
+/**
+ * This function writes one character's part of the index, so a save costs that character's notes
+ * instead of the whole party's
+ */
+void NotesSearchIndex::saveSegment(const QString &character)
+{
+	QString prefix = character + keySeparator;
+	QHash<QString, QHash<QString, QVector<Posting>>> sections;
+	for (auto document = this->documents.constBegin(); document != this->documents.constEnd(); ++document)
+	{
+		if (!document.key().startsWith(prefix))
+		{
+			continue;
+		}
+		QHash<QString, QVector<Posting>> &words = sections[document.key().mid(prefix.size())];
+		for (const QString &word : document.value())
+		{
+			words.insert(word, this->postings.value(word).value(document.key()));
+		}
+	}
+
+	// A removed character leaves nothing behind
+	if (sections.isEmpty() && !this->sequences.contains(character))
+	{
+		QFile::remove(segmentPath(character));
+		return;
+	}
+
+	QSaveFile file(segmentPath(character));
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "Could not write the notes search index:" << file.errorString();
+		return;
+	}
+
+	QDataStream out(&file);
+	out << magic << version << character << this->sequences.value(character, 0) << sections;
+	if (!file.commit())
+	{
+		qWarning() << "Could not write the notes search index:" << file.errorString();
+	}
+}
+
+void NotesSearchIndex::scheduleSave(const QString &character)
+{
+	this->changed.insert(character);
+	if (!this->incomplete)
+	{
+		this->saveTimer.start();
+	}
+}
+
+void NotesSearchIndex::removeDocument(const QString &key)
+{
+	auto document = this->documents.find(key);
+	if (document == this->documents.end())
+	{
+		return;
+	}
+
+	for (const QString &word : document.value())
+	{
+		auto found = this->postings.find(word);
+		if (found == this->postings.end())
+		{
+			continue;
+		}
+		found.value().remove(key);
+		if (found.value().isEmpty())
+		{
+			this->postings.erase(found);
+		}
+	}
+	this->documents.erase(document);
+}
@@ -0,0 +1,109 @@
+/*
+Name: notesSearchIndex.h
+Description: Persistent inverted index of every character's notes, one file per character under
+			 data/cache/notesSearch. Each word maps to the note sections it appears in and where, so searching
+			 the whole party's notes never opens a note. Kept current by NotesStore as notes are edited, created
+			 and removed, and only the files of characters whose notes changed are written again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef NOTESSEARCHINDEX_H
+#define NOTESSEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+class NotesSearchIndex : public QObject
+{
+	Q_OBJECT
+public:
+	// A section that matched, with the span of text to show when it is opened
+	struct Result
+	{
+		QString character;
+		QString section;
+		int offset = 0;
+		int length = 0;
+		double score = 0;
+	};
+
+	// One place a word appears in a section, by word number and by character
+	struct Posting
+	{
+		qint32 position = 0;
+		qint32 offset = 0;
+	};
+
+	// Returns the shared index, loading it from disk on the first call
+	static NotesSearchIndex &instance();
+
+	// Indexes again the characters whose notes were saved past the index, which reads each one's
+	// notes.index. Run while the app is idle so searching never opens a note
+	void prepare();
+
+	// Sections containing every word of the query, best first. The last word also matches words it begins,
+	// and sections where the words appear next to each other as a phrase rank above the rest
+	QList<Result> search(const QString &query, int limit = 100);
+
+	// Re-indexes one section from its full text, call after it changes
+	void updateSection(const QString &character, const QString &section, const QString &text);
+	void removeSection(const QString &character, const QString &section);
+	void removeCharacter(const QString &character);
+	// Records that the index holds every note edit of the character up to this one
+	void setSequence(const QString &character, qint64 sequence);
+	// Writes any pending changes to disk now instead of waiting for the save timer
+	void flush();
+
+	static constexpr quint32 magic = 0x4E4F5449; // "NOTI"
+	static constexpr quint32 version = 3;
+
+private:
+	struct Token
+	{
+		QString word;
+		Posting posting;
+	};
+
+	NotesSearchIndex();
+	~NotesSearchIndex();
+
+	static QString indexPath();
+	static QString segmentPath(const QString &character);
+	static QString documentKey(const QString &character, const QString &section);
+	static QVector<Token> tokenize(const QString &text);
+	bool load();
+	void rebuild();
+	void catchUp();
+	void indexCharacter(const QString &character);
+	bool loadSegment(const QString &path);
+	void save();
+	void saveSegment(const QString &character);
+	void scheduleSave(const QString &character);
+	void removeDocument(const QString &key);
+
+	// word -> section key -> places it appears, ordered by word so a prefix is a range of keys
+	QMap<QString, QHash<QString, QVector<Posting>>> postings;
+	// section key -> the words it holds, so a section can be taken out without scanning every word
+	QHash<QString, QStringList> documents;
+	// character -> number of the last note edit the index holds, notes saved past it are indexed again
+	QHash<QString, qint64> sequences;
+	// Characters whose file is written on the next save
+	QSet<QString> changed;
+	// True until the index holds every character's notes, it is built on the first search
+	bool incomplete = false;
+	// True once every character's notes were checked against their sequence
+	bool checked = false;
+	QTimer saveTimer;
+};
+
+#endif // NOTESSEARCHINDEX_H
@@ -0,0 +1,627 @@
+/*
+Name: notesStore.cpp
+Description: A character's notes, kept as one record per section plus a small notes.index listing each
+			 section's title, record, size and last update. Listing the notes reads only the index and opening
+			 a section reads only that section. Edits are appended to notes.journal and folded back into the
+			 section records once the journal grows or the notes page is left.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "notesStore.h"
+#include "characterStorage.h"
+#include "notesSearchIndex.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QMap>
+#include <QSet>
+#include <algorithm>
+
+static const QString timestampFormat = "dd-MM-yyyy|hh:mm:ss";
+
+// The journal is compacted once it is larger than this or a quarter of the notes,
+// so the cost of compacting stays a fraction of the edits that led to it
+static const qint64 minimumCompactBytes = 64 * 1024;
+
+// Sections larger than this are added to the notes search when compacted instead of on every save
+static const qint64 largeSectionBytes = 1024 * 1024;
+
+NotesStore::NotesStore(const QString &character)
+	: character(character)
+{
+}
+
+bool NotesStore::load()
+{
+	this->notes.clear();
+	this->removedRecords.clear();
+	this->preference = "lastUpdated";
+	this->legacy = false;
+	this->sequence = 0;
+	this->journalBytes = 0;
+	this->notesBytes = 0;
+
+	CharacterStorage &storage = CharacterStorage::instance();
+	bool ok = false;
+	QByteArray indexData = storage.read(this->character, "notes.index", &ok);
+	if (!ok)
+	{
+		if (!this->loadLegacy())
+		{
+			qDebug() << "Failed to open notes file";
+			return false;
+		}
+	}
+	else
+	{
+		this->notesBytes = indexData.size();
+		QJsonDocument indexDoc = QJsonDocument::fromJson(indexData);
+		if (indexDoc.isObject())
+		{
+			QJsonObject indexObj = indexDoc.object();
+			this->preference = indexObj["sortPreference"].toString("lastUpdated");
+			this->sequence = indexObj["journalSequence"].toVariant().toLongLong();
+			for (const QJsonValue &entry : indexObj["sections"].toArray())
+			{
+				QJsonObject entryObj = entry.toObject();
+				Section section;
+				section.name = entryObj["section"].toString();
+				section.record = entryObj["record"].toString();
+				section.lastUpdated = entryObj["lastUpdated"].toString();
+				section.size = entryObj["size"].toVariant().toLongLong();
+				section.stored = true;
+				if (!section.name.isEmpty() && !section.record.isEmpty())
+				{
+					this->notesBytes += section.size;
+					this->notes.append(section);
+				}
+			}
+		}
+		else
+		{
+			qDebug() << "Failed to parse notes index";
+		}
+	}
+
+	// Replay the edits that did not make it into the sections, stopping at a line cut off by a crash
+	QByteArray journal = storage.read(this->character, "notes.journal");
+	this->journalBytes = journal.size();
+	int replayed = 0;
+	QStringList touched;
+	for (const QByteArray &line : journal.split('\n'))
+	{
+		if (line.trimmed().isEmpty())
+		{
+			continue;
+		}
+
+		QJsonParseError error;
+		QJsonDocument entry = QJsonDocument::fromJson(line, &error);
+		if (error.error != QJsonParseError::NoError || !entry.isObject())
+		{
+			qWarning() << "Notes journal for" << this->character << "ends with an incomplete edit, it was skipped";
+			break;
+		}
+
+		// Edits already in the sections are left over from a compaction that stopped before emptying the journal
+		qint64 entrySequence = entry.object()["seq"].toVariant().toLongLong();
+		if (entrySequence <= this->sequence)
+		{
+			continue;
+		}
+		this->sequence = entrySequence;
+		if (this->apply(entry.object()))
+		{
+			replayed++;
+			touched.append(entry.object()["section"].toString());
+		}
+	}
+
+	if (replayed > 0)
+	{
+		qDebug() << "Recovered" << replayed << "note edits for" << this->character;
+		touched.removeDuplicates();
+		for (const QString &section : touched)
+		{
+			this->updateSearchIndex(section);
+		}
+	}
+
+	// Split the old notes.json up now so the next load only reads the index
+	if (this->legacy)
+	{
+		for (Section &section : this->notes)
+		{
+			if (section.record.isEmpty())
+			{
+				section.record = "note-" + QString::number(++this->sequence) + ".txt";
+			}
+		}
+		this->compact();
+	}
+	return true;
+}
+
+QStringList NotesStore::sections() const
+{
+	QList<const Section *> ordered;
+	for (const Section &section : this->notes)
+	{
+		ordered.append(&section);
+	}
+
+	// Everything needed to sort is in the index, no section text is read
+	if (this->preference == "lastUpdated")
+	{
+		std::stable_sort(ordered.begin(), ordered.end(), [](const Section *a, const Section *b) {
+			return QDateTime::fromString(a->lastUpdated, timestampFormat) >
+				   QDateTime::fromString(b->lastUpdated, timestampFormat);
+		});
+	}
+	else if (this->preference == "title")
+	{
+		std::stable_sort(ordered.begin(), ordered.end(), [](const Section *a, const Section *b) {
+			return a->name.compare(b->name, Qt::CaseInsensitive) < 0;
+		});
+	}
+
+	QStringList names;
+	for (const Section *section : ordered)
+	{
+		names.append(section->name);
+	}
+	return names;
+}
+
+QString NotesStore::text(const QString &section)
+{
+	int index = this->find(section);
+	if (index < 0)
+	{
+		return QString();
+	}
+	this->ensureLoaded(this->notes[index]);
+	return this->notes[index].text;
+}
+
+QString NotesStore::lastUpdated(const QString &section) const
+{
+	int index = this->find(section);
+	return index >= 0 ? this->notes[index].lastUpdated : QString();
+}
+
+qint64 NotesStore::size(const QString &section) const
+{
+	int index = this->find(section);
+	return index >= 0 ? this->notes[index].size : 0;
+}
+
+/**
+ * This function records the part of a note that changed, the text before the first difference and after
+ * the last difference is left out of the journal. The notes page uses it when the editor's own span of
+ * changed text does not fit the saved note
+ */
+void NotesStore::setText(const QString &section, const QString &text)
+{
+	int index = this->find(section);
+	if (index < 0)
+	{
+		return;
+	}
+
+	this->ensureLoaded(this->notes[index]);
+	const QString &old = this->notes[index].text;
+	if (old == text)
+	{
+		return;
+	}
+
+	int prefix = 0;
+	int maxPrefix = qMin(old.size(), text.size());
+	while (prefix < maxPrefix && old[prefix] == text[prefix])
+	{
+		prefix++;
+	}
+	int suffix = 0;
+	int maxSuffix = maxPrefix - prefix;
+	while (suffix < maxSuffix && old[old.size() - 1 - suffix] == text[text.size() - 1 - suffix])
+	{
+		suffix++;
+	}
+
+	// The difference is widened to whole characters, so an edit never holds half of a surrogate pair
+	if (prefix > 0 && old[prefix - 1].isHighSurrogate())
+	{
+		prefix--;
+	}
+	if (suffix > 0 && old[old.size() - suffix].isLowSurrogate())
+	{
+		suffix--;
+	}
+
+	this->replace(section, prefix, old.size() - prefix - suffix, text.mid(prefix, text.size() - prefix - suffix));
+}
+
+bool NotesStore::replace(const QString &section, int at, int removed, const QString &insert)
+{
+	if (!this->contains(section))
+	{
+		return false;
+	}
+	if (removed == 0 && insert.isEmpty())
+	{
+		return true;
+	}
+
+	QJsonObject entry;
+	entry["op"] = "edit";
+	entry["section"] = section;
+	entry["at"] = at;
+	entry["remove"] = removed;
+	entry["insert"] = insert;
+	entry["time"] = timestamp();
+	return this->append(entry);
+}
+
+void NotesStore::create(const QString &section)
+{
+	if (this->contains(section))
+	{
+		return;
+	}
+
+	QJsonObject entry;
+	entry["op"] = "create";
+	entry["section"] = section;
+	entry["time"] = timestamp();
+	this->append(entry);
+}
+
+void NotesStore::remove(const QString &section)
+{
+	if (!this->contains(section))
+	{
+		return;
+	}
+
+	QJsonObject entry;
+	entry["op"] = "remove";
+	entry["section"] = section;
+	this->append(entry);
+}
+
+/**
+ * This function folds the journal back into the section records. A record the index on disk lists is never
+ * written over, a changed section gets a new record and the index naming it is written last. Until the index
+ * is replaced a crash leaves the old records and the journal as they were, so replaying it gives the same notes
+ */
+bool NotesStore::compact()
+{
+	QSet<QString> used;
+	for (const Section &section : this->notes)
+	{
+		used.insert(section.record);
+	}
+
+	QMap<QString, QByteArray> records;
+	QMap<int, QString> moved; // section to the new record it is written to
+	for (int i = 0; i < this->notes.size(); i++)
+	{
+		const Section &section = this->notes[i];
+		if (!section.dirty)
+		{
+			continue;
+		}
+		QString record = section.record;
+		if (section.stored)
+		{
+			int copy = 0;
+			do
+			{
+				record = "note-" + QString::number(this->sequence) + "-" + QString::number(++copy) + ".txt";
+			} while (used.contains(record));
+			used.insert(record);
+			moved.insert(i, record);
+		}
+		records.insert(record, section.text.toUtf8());
+	}
+
+	CharacterStorage &storage = CharacterStorage::instance();
+	if (!records.isEmpty() && !storage.write(this->character, records))
+	{
+		qWarning() << "Failed to write notes for" << this->character;
+		return false;
+	}
+
+	// Everything up to here only added records nothing reads yet, replacing the index is what commits them
+	QStringList replaced;
+	for (auto it = moved.constBegin(); it != moved.constEnd(); ++it)
+	{
+		replaced.append(this->notes[it.key()].record);
+		this->notes[it.key()].record = it.value();
+	}
+	QByteArray indexData = this->index();
+	if (!storage.write(this->character, "notes.index", indexData))
+	{
+		qWarning() << "Failed to write notes index for" << this->character;
+		// The index on disk still lists the old records, the new ones are written over on the next try
+		int i = 0;
+		for (auto it = moved.constBegin(); it != moved.constEnd(); ++it)
+		{
+			this->notes[it.key()].record = replaced[i++];
+		}
+		return false;
+	}
+	this->notesBytes = indexData.size();
+	for (Section &section : this->notes)
+	{
+		section.dirty = false;
+		section.stored = true;
+		this->notesBytes += section.size;
+		if (section.searchStale)
+		{
+			section.searchStale = false;
+			this->updateSearchIndex(section.name);
+		}
+	}
+	if (storage.write(this->character, "notes.journal", QByteArray()))
+	{
+		this->journalBytes = 0;
+	}
+
+	// Nothing lists these any more, a crash before they are gone only leaves unused records behind
+	this->removedRecords.append(replaced);
+	for (const QString &record : this->removedRecords)
+	{
+		storage.removeRecord(this->character, record);
+	}
+	this->removedRecords.clear();
+	if (this->legacy && storage.removeRecord(this->character, "notes.json"))
+	{
+		this->legacy = false;
+	}
+	return true;
+}
+
+QString NotesStore::timestamp()
+{
+	return QDateTime::currentDateTime().toString(timestampFormat);
+}
+
+qint64 NotesStore::lastSavedEdit(const QString &character)
+{
+	CharacterStorage &storage = CharacterStorage::instance();
+	QJsonObject indexObj = QJsonDocument::fromJson(storage.read(character, "notes.index")).object();
+	qint64 last = indexObj["journalSequence"].toVariant().toLongLong();
+
+	// The journal is empty unless the app stopped before the notes page was left
+	if (storage.info(character, "notes.journal").size > 0)
+	{
+		for (const QByteArray &line : storage.read(character, "notes.journal").split('\n'))
+		{
+			QJsonDocument entry = QJsonDocument::fromJson(line);
+			if (entry.isObject())
+			{
+				last = qMax(last, entry.object()["seq"].toVariant().toLongLong());
+			}
+		}
+	}
+	return last;
+}
+
+QByteArray NotesStore::emptyIndex()
+{
+	QJsonObject indexObj;
+	indexObj["sortPreference"] = "lastUpdated";
+	indexObj["journalSequence"] = 0;
+	indexObj["sections"] = QJsonArray();
+	return QJsonDocument(indexObj).toJson(QJsonDocument::Compact);
+}
+
+int NotesStore::find(const QString &section) const
+{
+	for (int i = 0; i < this->notes.size(); i++)
+	{
+		if (this->notes[i].name == section)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+bool NotesStore::ensureLoaded(Section &section) const
+{
+	if (section.loaded)
+	{
+		return true;
+	}
+
+	bool ok = false;
+	QByteArray data = CharacterStorage::instance().read(this->character, section.record, &ok);
+	section.text = QString::fromUtf8(data);
+	section.loaded = true;
+	if (!ok)
+	{
+		qWarning() << "Failed to open note" << section.name << "for" << this->character;
+	}
+	return ok;
+}
+
+/**
+ * This function reads notes from the single notes.json they were kept in before sections had their own records
+ */
+bool NotesStore::loadLegacy()
+{
+	bool ok = false;
+	QByteArray notesData = CharacterStorage::instance().read(this->character, "notes.json", &ok);
+	if (!ok)
+	{
+		return false;
+	}
+	this->legacy = true;
+
+	QJsonDocument notesDoc = QJsonDocument::fromJson(notesData);
+	if (!notesDoc.isObject())
+	{
+		qDebug() << "Failed to parse notes file";
+		return true;
+	}
+
+	QJsonObject notesObj = notesDoc.object();
+	this->preference = notesObj["sortPreference"].toString("lastUpdated");
+	this->sequence = notesObj["journalSequence"].toVariant().toLongLong();
+	for (const QJsonValue &note : notesObj["notes"].toArray())
+	{
+		QJsonObject noteObj = note.toObject();
+		Section section;
+		section.name = noteObj["section"].toString();
+		section.text = noteObj["notes"].toString();
+		section.lastUpdated = noteObj["lastUpdated"].toString();
+		section.size = section.text.toUtf8().size();
+		section.loaded = true;
+		section.dirty = true;
+		if (!section.name.isEmpty())
+		{
+			this->notes.append(section);
+		}
+	}
+	return true;
+}
+
+bool NotesStore::apply(const QJsonObject &entry)
+{
+	QString op = entry["op"].toString();
+	QString section = entry["section"].toString();
+	int index = this->find(section);
+
+	if (op == "create" && index < 0)
+	{
+		// Named after the edit, so replaying the journal gives the section the same record again
+		Section created;
+		created.name = section;
+		created.record = "note-" + entry["seq"].toVariant().toString() + ".txt";
+		created.lastUpdated = entry["time"].toString();
+		created.loaded = true;
+		created.dirty = true;
+		this->notes.append(created);
+		return true;
+	}
+	if (op == "remove" && index >= 0)
+	{
+		if (!this->notes[index].record.isEmpty())
+		{
+			this->removedRecords.append(this->notes[index].record);
+		}
+		this->notes.removeAt(index);
+		return true;
+	}
+	if (op == "edit" && index >= 0)
+	{
+		Section &note = this->notes[index];
+		this->ensureLoaded(note);
+		int at = entry["at"].toInt();
+		int removed = entry["remove"].toInt();
+		if (at < 0 || removed < 0 || at + removed > note.text.size())
+		{
+			qWarning() << "Note edit does not fit section" << section << ", it was skipped";
+			return false;
+		}
+		QString insert = entry["insert"].toString();
+		note.size += insert.toUtf8().size() - note.text.mid(at, removed).toUtf8().size();
+		note.text.replace(at, removed, insert);
+		note.lastUpdated = entry["time"].toString();
+		note.dirty = true;
+		return true;
+	}
+	return false;
+}
+
+bool NotesStore::append(QJsonObject entry)
+{
+	// An edit that does not apply is not journaled either, replaying it would fail the same way
+	entry["seq"] = this->sequence + 1;
+	if (!this->apply(entry))
+	{
+		return false;
+	}
+	this->sequence++;
+
+	// Re-reading a huge section for the search on every save would hold up typing
+	QString section = entry["section"].toString();
+	int index = this->find(section);
+	if (index >= 0 && this->notes[index].size > largeSectionBytes)
+	{
+		this->notes[index].searchStale = true;
+	}
+	else
+	{
+		this->updateSearchIndex(section);
+	}
+
+	QByteArray line = QJsonDocument(entry).toJson(QJsonDocument::Compact) + "\n";
+	if (!CharacterStorage::instance().append(this->character, "notes.journal", line))
+	{
+		// Without the journal the edit is only in memory, writing the sections out keeps it
+		this->compact();
+		return true;
+	}
+	this->journalBytes += line.size();
+
+	if (this->journalBytes > qMax(minimumCompactBytes, this->notesBytes / 4))
+	{
+		this->compact();
+	}
+	return true;
+}
+
+void NotesStore::updateSearchIndex(const QString &section)
+{
+	NotesSearchIndex &search = NotesSearchIndex::instance();
+	int index = this->find(section);
+	if (index < 0)
+	{
+		search.removeSection(this->character, section);
+	}
+	else
+	{
+		this->ensureLoaded(this->notes[index]);
+		search.updateSection(this->character, section, this->notes[index].text);
+	}
+
+	// Once no section is waiting to be indexed, the search holds every edit up to this one
+	for (const Section &note : this->notes)
+	{
+		if (note.searchStale)
+		{
+			return;
+		}
+	}
+	search.setSequence(this->character, this->sequence);
+}
+
+QByteArray NotesStore::index() const
+{
+	QJsonArray sectionsArr;
+	for (const Section &section : this->notes)
+	{
+		QJsonObject entryObj;
+		entryObj["section"] = section.name;
+		entryObj["record"] = section.record;
+		entryObj["lastUpdated"] = section.lastUpdated;
+		entryObj["size"] = section.size;
+		sectionsArr.append(entryObj);
+	}
+
+	QJsonObject indexObj;
+	indexObj["sortPreference"] = this->preference;
+	indexObj["journalSequence"] = this->sequence;
+	indexObj["sections"] = sectionsArr;
+	return QJsonDocument(indexObj).toJson(QJsonDocument::Compact);
+}
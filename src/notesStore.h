@@ -0,0 +1,93 @@
+/*
+Name: notesStore.h
+Description: A character's notes, kept as one record per section plus a small notes.index listing each
+			 section's title, record, size and last update. Listing the notes reads only the index and opening
+			 a section reads only that section. Edits are appended to notes.journal and folded back into the
+			 section records once the journal grows or the notes page is left.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef NOTESSTORE_H
+#define NOTESSTORE_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class NotesStore
+{
+public:
+	explicit NotesStore(const QString &character = QString());
+
+	// Reads notes.index and replays any journal left from before, returns false if there are no notes to read.
+	// Notes still in the old single notes.json are split into sections the first time they are loaded
+	bool load();
+
+	// Section titles in the order picked by the sort preference
+	QStringList sections() const;
+	const QString &sortPreference() const { return this->preference; }
+	bool contains(const QString &section) const { return this->find(section) >= 0; }
+	// Reads the section's record the first time it is asked for
+	QString text(const QString &section);
+	QString lastUpdated(const QString &section) const;
+	qint64 size(const QString &section) const;
+
+	// Each change is written to the journal right away, only what changed is written.
+	// Used by the notes page when an edit from replace() does not fit the section
+	void setText(const QString &section, const QString &text);
+	// Replaces removed characters from at with insert, for editors that know what changed.
+	// Returns false if the span does not fit the section, nothing is written then
+	bool replace(const QString &section, int at, int removed, const QString &insert);
+	void create(const QString &section);
+	void remove(const QString &section);
+
+	// Writes the changed sections to new records, then the index naming them, then empties the journal
+	bool compact();
+	bool hasJournal() const { return this->journalBytes > 0; }
+	// Number of the last edit the notes hold
+	qint64 lastEdit() const { return this->sequence; }
+	// Number of the last edit saved for a character, read from notes.index and notes.journal without loading the notes
+	static qint64 lastSavedEdit(const QString &character);
+
+	static QString timestamp();
+	// What a new character starts with
+	static QByteArray emptyIndex();
+
+private:
+	struct Section
+	{
+		QString name;
+		QString record; // record holding the text, named after the edit that created or last compacted it
+		QString text;
+		QString lastUpdated;
+		qint64 size = 0;
+		bool loaded = false;
+		bool dirty = false; // changed since its record was written
+		bool stored = false; // record is listed in notes.index on disk, so it is never written over
+		bool searchStale = false; // changed since the notes search last read it
+	};
+
+	int find(const QString &section) const;
+	bool ensureLoaded(Section &section) const;
+	bool loadLegacy();
+	bool apply(const QJsonObject &entry);
+	bool append(QJsonObject entry);
+	// Keeps the notes search in step with a section that was just changed, created or removed
+	void updateSearchIndex(const QString &section);
+	QByteArray index() const;
+
+	QString character;
+	QList<Section> notes;
+	QStringList removedRecords; // records of removed sections, deleted once the index no longer lists them
+	QString preference = "lastUpdated";
+	bool legacy = false;	 // still has a notes.json to remove after the first compaction
+	qint64 sequence = 0;	 // number of the last edit, the index records which ones the sections already hold
+	qint64 journalBytes = 0; // size of notes.journal, compacted once it is large compared to the notes
+	qint64 notesBytes = 0;
+};
+
+#endif // NOTESSTORE_H
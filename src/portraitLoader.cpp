@@ -0,0 +1,113 @@
+/*
+Name: portraitLoader.cpp
+Description: Decodes, crops, and scales portraits on the thread pool so pages never decode
+			 a full resolution image on the GUI thread.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "portraitLoader.h"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+PortraitLoader::PortraitLoader(QObject *parent) : QObject(parent)
+{
+}
+
+PortraitLoader::~PortraitLoader()
+{
+	this->cancel();
+}
+
+void PortraitLoader::load(const QString &imagePath, const QSize &size, bool crop)
+{
+	this->cancel();
+
+	// The worker only shares the flag, so it never touches this object once it is destroyed
+	std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+	this->cancelled = cancelled;
+	this->imagePath = imagePath;
+
+	this->watcher = new QFutureWatcher<QImage>(this);
+	connect(this->watcher, &QFutureWatcher<QImage>::finished, this, [this]()
+	{
+		QImage image = this->watcher->result();
+		this->watcher->deleteLater();
+		this->watcher = nullptr;
+
+		// QPixmaps can only be made on the GUI thread
+		if (image.isNull())
+		{
+			qDebug() << "Failed to load image at path:" << this->imagePath;
+			emit failed(this->imagePath);
+		}
+		else
+		{
+			emit loaded(QPixmap::fromImage(image));
+		}
+	});
+
+	this->watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [imagePath, size, crop, cancelled]()
+	{
+		if (*cancelled)
+		{
+			return QImage();
+		}
+		QImage image = decode(imagePath, size, crop);
+		return *cancelled ? QImage() : image;
+	}));
+}
+
+void PortraitLoader::cancel()
+{
+	if (this->cancelled)
+	{
+		*this->cancelled = true;
+		this->cancelled.reset();
+	}
+
+	// Drop the watcher so a decode that is already running can not deliver its result
+	if (this->watcher)
+	{
+		this->watcher->disconnect(this);
+		this->watcher->deleteLater();
+		this->watcher = nullptr;
+	}
+}
+
+QImage PortraitLoader::decode(const QString &imagePath, const QSize &size, bool crop)
+{
+	QImageReader reader(imagePath);
+	QSize fullSize = reader.size();
+	if (!fullSize.isValid())
+	{
+		// Some formats can not report their size without decoding, fall back to a full read
+		QImage image = reader.read();
+		if (image.isNull())
+		{
+			return image;
+		}
+		fullSize = image.size();
+		QRect cropRect = crop ? QRect(QPoint(0, 0), size.scaled(fullSize, Qt::KeepAspectRatio)) : image.rect();
+		cropRect.moveCenter(image.rect().center());
+		return image.copy(cropRect).scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	}
+
+	// Center crop to the target aspect ratio, ex. 2:3 for the character sheet
+	QRect cropRect(QPoint(0, 0), fullSize);
+	if (crop)
+	{
+		cropRect.setSize(size.scaled(fullSize, Qt::KeepAspectRatio));
+		cropRect.moveCenter(QRect(QPoint(0, 0), fullSize).center());
+		reader.setClipRect(cropRect);
+	}
+
+	// Let the reader scale while decoding, JPEGs are scaled before they are fully decoded
+	reader.setScaledSize(cropRect.size().scaled(size, Qt::KeepAspectRatio));
+	return reader.read();
+}
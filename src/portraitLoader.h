@@ -0,0 +1,50 @@
+/*
+Name: portraitLoader.h
+Description: Decodes, crops, and scales portraits on the thread pool so pages never decode
+			 a full resolution image on the GUI thread.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef PORTRAITLOADER_H
+#define PORTRAITLOADER_H
+
+#include <QFutureWatcher>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+class PortraitLoader : public QObject
+{
+	Q_OBJECT
+public:
+	explicit PortraitLoader(QObject *parent = nullptr);
+	~PortraitLoader();
+
+	// Starts decoding imagePath in the background, cancelling any decode still in progress.
+	// If crop is true the image is center cropped to the aspect ratio of size before scaling,
+	// otherwise it is scaled to fit inside size.
+	void load(const QString &imagePath, const QSize &size, bool crop = true);
+	void cancel();
+
+	// Reads only the pixels that are needed, safe to call from any thread
+	static QImage decode(const QString &imagePath, const QSize &size, bool crop = true);
+
+signals:
+	void loaded(const QPixmap &pixmap);
+	void failed(const QString &imagePath);
+
+private:
+	QFutureWatcher<QImage> *watcher = nullptr;
+	std::shared_ptr<std::atomic_bool> cancelled;
+	QString imagePath;
+};
+
+#endif // PORTRAITLOADER_H
@@ -4,15 +4,12 @@ Description: Implementation of the AddCharacter class, which allows users to cre
 Authors: Chanu Lee
 Other Sources: ...
 Date Created: 11/23/2024
-Last Modified: 11/23/2024
+Last Modified: 10/17/2026
 */
 
 #include "addCharacter.h"
 
-#include <iostream>
-
-#include <QDir>
-#include <QFile>
+#include <QDebug>
 #include <QLayout>
 #include <QPushButton>
 /**
@@ -146,80 +143,8 @@ void RaceWidget::nextPage()
 
 void RaceWidget::loadRaces()
 {
-    QFile file("data/databases/Races.tsv"); // read in the file
-    qDebug() << "Current working directory:" << QDir::currentPath();
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        // error checking for debugging
-        std::cerr << "Failed to open file" << std::endl;
-        return;
-    }
-
-    QTextStream in(&file); // read in the file
-    bool isHeader = true;  // our first line is a header
-
-    while (!in.atEnd())
-    {
-        QString line = in.readLine(); // read in the line
-        if (isHeader)
-        {
-            isHeader = false; // we are no longer on the header
-            continue;         // skip the header
-        }
-
-        QStringList fields = line.split("\t"); // split the line by \t
-        if (fields.size() < 10)
-        {
-            continue; // ensure we get all the fields
-        }
-
-        QList<QString> *abilities = new QList<QString>(fields[9].split(", "));
-
-        QString name = fields[0];
-        QString subRaceName = fields[4];
-
-        // See whether the race has subraces or not
-        bool subRacesExist = subRaceName.isEmpty() ? false : true;
-
-        if (!this->races.contains(name))
-        {
-            // Create new entry in the list of races if it does not yet exist
-            QMap<QString, SubRaceInfo *> subRaces;
-            // Fill out info
-            RaceInfo *info = new RaceInfo{
-                fields[1],
-                fields[2],
-                fields[3],
-                subRacesExist,
-                subRaces};
-
-            // Add the race to the combobox
-            this->raceComboBox->addItem(name);
-            this->races[name] = info;
-        }
-
-        // List of subraces associated with a race
-        QMap<QString, SubRaceInfo *> subRaces = this->races[name]->subRaces;
-        // Fill out info
-        SubRaceInfo *subRaceInfo = new SubRaceInfo{
-            fields[5],
-            fields[6],
-            fields[7],
-            fields[8],
-            abilities};
-
-        if (subRacesExist)
-        {
-            // If the race has subraces, create a new entry for the subrace in the list of subraces
-            this->races[name]->subRaces[subRaceName] = subRaceInfo;
-        }
-        else
-        {
-            // If not, then create entry in the list of subraces for info associated with the race
-            // under the race's name
-            this->races[name]->subRaces[name] = subRaceInfo;
-        }
-    }
+    // Races.tsv is parsed once by the shared database, we only need the names here
+    this->raceComboBox->addItems(ReferenceDatabase::instance().raceNames());
 }
 
 /**
@@ -227,14 +152,13 @@ void RaceWidget::loadRaces()
  */
 void RaceWidget::updateRaceInfo(const QString &name)
 {
-    if (!this->races.contains(name))
+    const RaceInfo *info = ReferenceDatabase::instance().raceInfo(name);
+    if (!info)
     {
         qWarning() << "Race not found:" << name;
         return;
     }
 
-    RaceInfo *info = this->races[name];
-
     this->header->setText("<h1>" + name + " " + info->book + " pg " + info->page + "</h1>");
 
     this->portrait->getImage(name);
@@ -247,8 +171,7 @@ void RaceWidget::updateRaceInfo(const QString &name)
     if (info->subRacesExist)
     {
         this->subRaceComboBox->setEnabled(true);
-        QMap<QString, SubRaceInfo *> subRaces = info->subRaces;
-        for (auto item = subRaces.cbegin(); item != subRaces.cend(); ++item)
+        for (auto item = info->subRaces.cbegin(); item != info->subRaces.cend(); ++item)
         {
             this->subRaceComboBox->addItem(item.key());
         }
@@ -260,6 +183,24 @@ void RaceWidget::updateRaceInfo(const QString &name)
     }
 }
 
+/**
+ * This function returns the info for the chosen race/subrace, or nullptr if nothing valid is selected
+ */
+const SubRaceInfo *RaceWidget::currentSubRaceInfo()
+{
+    QString raceName = this->raceComboBox->currentText();
+    const RaceInfo *info = ReferenceDatabase::instance().raceInfo(raceName);
+    if (!info)
+    {
+        return nullptr;
+    }
+
+    // Races without subraces keep their info under the race's own name
+    QString subRaceName = info->subRacesExist ? this->subRaceComboBox->currentText() : raceName;
+    auto subRace = info->subRaces.constFind(subRaceName);
+    return subRace == info->subRaces.constEnd() ? nullptr : &subRace.value();
+}
+
 // Update info on the page associated with subraces
 void RaceWidget::updateSubRaceInfo(const QString &subRaceName)
 {
@@ -268,15 +209,11 @@ void RaceWidget::updateSubRaceInfo(const QString &subRaceName)
         return;
     }
 
-    QString raceName = this->raceComboBox->currentText();
-    SubRaceInfo *subRaceInfo;
-    if (!this->races[raceName]->subRacesExist)
+    const SubRaceInfo *subRaceInfo = this->currentSubRaceInfo();
+    if (!subRaceInfo)
     {
-        subRaceInfo = this->races[raceName]->subRaces[raceName];
-    }
-    else
-    {
-        subRaceInfo = this->races[raceName]->subRaces[subRaceName];
+        qWarning() << "SubRace not found:" << subRaceName;
+        return;
     }
 
     this->abilityScoreIncrease->setText("<h4>Ability Score Increase (Str, Dex, Con, Int, Wis, Cha):</h4><br>" + subRaceInfo->abilityScoreIncrease);
@@ -288,7 +225,7 @@ void RaceWidget::updateSubRaceInfo(const QString &subRaceName)
     this->languages->setText("<h4>Languages:</h4><br>" + subRaceInfo->languages);
 
     this->abilities->setText("<h4>Abilities:</h4>");
-    for (QString ability : *subRaceInfo->abilities)
+    for (const QString &ability : subRaceInfo->abilities)
     {
         this->abilities->setText(this->abilities->text() + "<br>" + ability);
     }
@@ -315,16 +252,8 @@ QString RaceWidget::getSubRace()
  */
 QString RaceWidget::getAbilityScoreIncrease()
 {
-    QString raceName = this->raceComboBox->currentText();
-    if (this->races[raceName]->subRacesExist)
-    {
-        QString subRaceName = this->subRaceComboBox->currentText();
-        return this->races[raceName]->subRaces[subRaceName]->abilityScoreIncrease;
-    }
-    else
-    {
-        return this->races[raceName]->subRaces[raceName]->abilityScoreIncrease;
-    }
+    const SubRaceInfo *info = this->currentSubRaceInfo();
+    return info ? info->abilityScoreIncrease : QString();
 }
 
 /**
@@ -332,16 +261,8 @@ QString RaceWidget::getAbilityScoreIncrease()
  */
 QString RaceWidget::getSize()
 {
-    QString raceName = this->raceComboBox->currentText();
-    if (this->races[raceName]->subRacesExist)
-    {
-        QString subRaceName = this->subRaceComboBox->currentText();
-        return this->races[raceName]->subRaces[subRaceName]->size;
-    }
-    else
-    {
-        return this->races[raceName]->subRaces[raceName]->size;
-    }
+    const SubRaceInfo *info = this->currentSubRaceInfo();
+    return info ? info->size : QString();
 }
 
 /**
@@ -349,16 +270,8 @@ QString RaceWidget::getSize()
  */
 QString RaceWidget::getSpeed()
 {
-    QString raceName = this->raceComboBox->currentText();
-    if (this->races[raceName]->subRacesExist)
-    {
-        QString subRaceName = this->subRaceComboBox->currentText();
-        return this->races[raceName]->subRaces[subRaceName]->speed;
-    }
-    else
-    {
-        return this->races[raceName]->subRaces[raceName]->speed;
-    }
+    const SubRaceInfo *info = this->currentSubRaceInfo();
+    return info ? info->speed : QString();
 }
 
 /**
@@ -366,31 +279,16 @@ QString RaceWidget::getSpeed()
  */
 QString RaceWidget::getLanguages()
 {
-    QString raceName = this->raceComboBox->currentText();
-    if (this->races[raceName]->subRacesExist)
-    {
-        QString subRaceName = this->subRaceComboBox->currentText();
-        return this->races[raceName]->subRaces[subRaceName]->languages;
-    }
-    else
-    {
-        return this->races[raceName]->subRaces[raceName]->languages;
-    }
+    const SubRaceInfo *info = this->currentSubRaceInfo();
+    return info ? info->languages : QString();
 }
 
 /**
  * This function returns the abilities from chosen race/subrace
  */
-QList<QString> *RaceWidget::getAbilities()
+const QList<QString> *RaceWidget::getAbilities()
 {
-    QString raceName = this->raceComboBox->currentText();
-    if (this->races[raceName]->subRacesExist)
-    {
-        QString subRaceName = this->subRaceComboBox->currentText();
-        return this->races[raceName]->subRaces[subRaceName]->abilities;
-    }
-    else
-    {
-        return this->races[raceName]->subRaces[raceName]->abilities;
-    }
+    static const QList<QString> none;
+    const SubRaceInfo *info = this->currentSubRaceInfo();
+    return info ? &info->abilities : &none;
 }
@@ -0,0 +1,240 @@
+/*
+Name: referenceDatabase.cpp
+Description: Process-wide, read-only view of every table in data/databases.
+			 Each table is read once out of the mapped database snapshot, the first time any page asks for it.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "referenceDatabase.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QRegularExpression>
+
+const ReferenceDatabase &ReferenceDatabase::instance()
+{
+	// Constructed on first use, C++11 guarantees this is only done once
+	static const ReferenceDatabase database;
+	return database;
+}
+
+ReferenceDatabase::ReferenceDatabase() : snapshot(QDir::currentPath() + "/data/databases")
+{
+	// Classes have to be loaded first because the feature files are named after them
+	this->loadClasses();
+	this->loadRaces();
+	this->loadBackgrounds();
+	this->loadFeatures();
+	this->loadFeats();
+	this->loadSpellSlots();
+	this->loadSpells();
+	this->loadItems();
+}
+
+void ReferenceDatabase::loadClasses()
+{
+	for (int i = 0; i < this->snapshot.rowCount("ClassInventory.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = this->snapshot.row("ClassInventory.tsv", i);
+		if (fields.size() < 12)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		// Equipment choices are written as groups in parentheses, ex. (Greataxe, Martial Melee), (2 Handaxes, Simple)
+		QList<QList<QString>> choices;
+		QRegularExpression re("\\([^)]+\\)");
+		QRegularExpressionMatchIterator match = re.globalMatch(fields[9].toString());
+		while (match.hasNext())
+		{
+			QString itemsStr = match.next().captured();
+			itemsStr = itemsStr.mid(1, itemsStr.size() - 2);
+			choices.append(itemsStr.split(", "));
+		}
+
+		ClassInfo info{
+			fields[1].toString(),
+			fields[2].toString(),
+			fields[3].toString().split(", "),
+			fields[4].toString().split(", "),
+			fields[5].toString().split(", "),
+			fields[6].toString().split(", "),
+			fields[7].toInt(),
+			fields[8].toString().split(", "),
+			choices,
+			fields[10].toString().split(", "),
+			fields[11].toString()};
+
+		QString name = fields[0].toString();
+		if (!this->classMap.contains(name))
+		{
+			this->classOrder.append(name);
+		}
+		this->classMap[name] = info;
+	}
+}
+
+void ReferenceDatabase::loadRaces()
+{
+	for (int i = 0; i < this->snapshot.rowCount("Races.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = this->snapshot.row("Races.tsv", i);
+		if (fields.size() < 10)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		QString name = fields[0].toString();
+		QString subRaceName = fields[4].toString();
+
+		// See whether the race has subraces or not
+		bool subRacesExist = !subRaceName.isEmpty();
+
+		if (!this->raceMap.contains(name))
+		{
+			// Create new entry in the list of races if it does not yet exist
+			this->raceMap[name] = RaceInfo{
+				fields[1].toString(),
+				fields[2].toString(),
+				fields[3].toString(),
+				subRacesExist,
+				{}};
+			this->raceOrder.append(name);
+		}
+
+		SubRaceInfo subRaceInfo{
+			fields[5].toString(),
+			fields[6].toString(),
+			fields[7].toString(),
+			fields[8].toString(),
+			fields[9].toString().split(", ")};
+
+		// Races without subraces keep their info under the race's own name
+		this->raceMap[name].subRaces[subRacesExist ? subRaceName : name] = subRaceInfo;
+	}
+}
+
+void ReferenceDatabase::loadBackgrounds()
+{
+	for (int i = 0; i < this->snapshot.rowCount("Backgrounds.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = this->snapshot.row("Backgrounds.tsv", i);
+		if (fields.size() < 9)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		BackgroundInfo info{
+			fields[1].toString(), // page
+			fields[2].toString(), // description
+			fields[3].toString(), // skill proficiencies
+			fields[4].toString(), // tool proficiencies
+			fields[5].toString(), // languages
+			fields[6].toString(), // equipment
+			fields[7].toString(), // feature
+			fields[8].toString()  // feature description
+		};
+
+		QString name = fields[0].toString();
+		if (!this->backgroundMap.contains(name))
+		{
+			this->backgroundOrder.append(name);
+		}
+		this->backgroundMap[name] = info;
+	}
+}
+
+void ReferenceDatabase::loadFeatures()
+{
+	// Every class has its own feature table named after it, ex. Wizard.tsv
+	for (const QString &className : this->classOrder)
+	{
+		QList<FeatureInfo> features;
+		const QString table = className + ".tsv";
+		for (int i = 0; i < this->snapshot.rowCount(table); i++)
+		{
+			const DatabaseSnapshot::Row fields = this->snapshot.row(table, i);
+			if (fields.size() < 5)
+			{
+				continue; // ensure we get all the fields
+			}
+
+			features.append(FeatureInfo{
+				fields[1].toString(),
+				fields[2].toString(),
+				fields[3].toInt(),
+				fields[4].toString()});
+		}
+		this->featureMap[className] = features;
+	}
+}
+
+void ReferenceDatabase::loadFeats()
+{
+	for (int i = 0; i < this->snapshot.rowCount("Feats.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = this->snapshot.row("Feats.tsv", i);
+		if (fields.size() < 8)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		this->featMap[fields[0].toString()] = FeatInfo{
+			fields[1].toString(),
+			fields[2].toInt(),
+			fields[3].toString(),
+			fields[4].toString(),
+			fields[5].toString(),
+			fields[6].toString(),
+			fields[7].toString()};
+	}
+}
+
+void ReferenceDatabase::loadSpellSlots()
+{
+	this->spellSlotTable.load(this->snapshot);
+}
+
+void ReferenceDatabase::loadSpells()
+{
+	this->spells.load(this->snapshot);
+}
+
+void ReferenceDatabase::loadItems()
+{
+	this->items.load(this->snapshot);
+}
+
+const ClassInfo *ReferenceDatabase::classInfo(const QString &name) const
+{
+	auto it = this->classMap.constFind(name);
+	return it == this->classMap.constEnd() ? nullptr : &it.value();
+}
+
+const RaceInfo *ReferenceDatabase::raceInfo(const QString &name) const
+{
+	auto it = this->raceMap.constFind(name);
+	return it == this->raceMap.constEnd() ? nullptr : &it.value();
+}
+
+const BackgroundInfo *ReferenceDatabase::backgroundInfo(const QString &name) const
+{
+	auto it = this->backgroundMap.constFind(name);
+	return it == this->backgroundMap.constEnd() ? nullptr : &it.value();
+}
+
+const QList<FeatureInfo> &ReferenceDatabase::features(const QString &className) const
+{
+	static const QList<FeatureInfo> noFeatures;
+	auto it = this->featureMap.constFind(className);
+	return it == this->featureMap.constEnd() ? noFeatures : it.value();
+}
+
+const FeatInfo *ReferenceDatabase::featInfo(const QString &name) const
+{
+	auto it = this->featMap.constFind(name);
+	return it == this->featMap.constEnd() ? nullptr : &it.value();
+}
@@ -0,0 +1,155 @@
+/*
+Name: referenceDatabase.h
+Description: Process-wide, read-only view of every table in data/databases.
+			 Each table is read once out of the mapped database snapshot, the first time any page asks for it.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef REFERENCEDATABASE_H
+#define REFERENCEDATABASE_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+
+#include "databaseSnapshot.h"
+#include "itemCompendium.h"
+#include "spellCompendium.h"
+#include "spellSlotTable.h"
+
+struct ClassInfo
+{
+	QString book;
+	QString page;
+	QList<QString> armorProficiencies;
+	QList<QString> weaponProficiencies;
+	QList<QString> toolProficiencies;
+	QList<QString> savingThrows;
+	int numSkills;
+	QList<QString> skillProficiencies;
+	QList<QList<QString>> equipmentChoices;
+	QList<QString> givenEquipment;
+	QString summary;
+};
+
+struct SubRaceInfo
+{
+	QString abilityScoreIncrease;
+	QString size;
+	QString speed;
+	QString languages;
+	QList<QString> abilities;
+};
+
+struct RaceInfo
+{
+	QString book;
+	QString page;
+	QString summary;
+	bool subRacesExist;
+	QMap<QString, SubRaceInfo> subRaces;
+};
+
+struct BackgroundInfo
+{
+	QString page;
+	QString description;
+	QString skillProficiency;
+	QString toolProficiency;
+	QString languages;
+	QString equipment;
+	QString feature;
+	QString featureDescription;
+};
+
+struct FeatureInfo
+{
+	QString subClass;
+	QString featureName;
+	int level;
+	QString description;
+};
+
+struct FeatInfo
+{
+	QString abilityScoreReqs;
+	int spellcastingReq;
+	QString proficiencyReq;
+	QString book;
+	QString page;
+	QString abilityScoreImprovements;
+	QString description;
+};
+
+class ReferenceDatabase
+{
+public:
+	// Returns the shared database, loading every table on the first call
+	static const ReferenceDatabase &instance();
+
+	// Class names in the order they appear in ClassInventory.tsv
+	const QStringList &classNames() const { return this->classOrder; }
+	// Returns nullptr if the class is not in ClassInventory.tsv
+	const ClassInfo *classInfo(const QString &name) const;
+
+	// Race names in the order they appear in Races.tsv
+	const QStringList &raceNames() const { return this->raceOrder; }
+	// Returns nullptr if the race is not in Races.tsv
+	const RaceInfo *raceInfo(const QString &name) const;
+
+	// Background names in the order they appear in Backgrounds.tsv
+	const QStringList &backgroundNames() const { return this->backgroundOrder; }
+	// Returns nullptr if the background is not in Backgrounds.tsv
+	const BackgroundInfo *backgroundInfo(const QString &name) const;
+
+	// Features from the class's own tsv file, empty if the class has none
+	const QList<FeatureInfo> &features(const QString &className) const;
+
+	const QMap<QString, FeatInfo> &feats() const { return this->featMap; }
+	// Returns nullptr if the feat is not in Feats.tsv
+	const FeatInfo *featInfo(const QString &name) const;
+
+	// Spell slots from SpellSlots.csv by class, character level and spell level
+	const SpellSlotTable &spellSlots() const { return this->spellSlotTable; }
+
+	// Every spell in Spells.tsv, indexed for the add spell dialogs
+	const SpellCompendium &spellCompendium() const { return this->spells; }
+
+	// Every item in Items.tsv, indexed by name for the add item dialogs and carried weight
+	const ItemCompendium &itemCompendium() const { return this->items; }
+
+private:
+	ReferenceDatabase();
+	ReferenceDatabase(const ReferenceDatabase &) = delete;
+	ReferenceDatabase &operator=(const ReferenceDatabase &) = delete;
+
+	void loadClasses();
+	void loadRaces();
+	void loadBackgrounds();
+	void loadFeatures();
+	void loadFeats();
+	void loadSpellSlots();
+	void loadSpells();
+	void loadItems();
+
+	// Kept mapped for the life of the program so its fields stay readable
+	DatabaseSnapshot snapshot;
+
+	QStringList classOrder;
+	QMap<QString, ClassInfo> classMap;
+	QStringList raceOrder;
+	QMap<QString, RaceInfo> raceMap;
+	QStringList backgroundOrder;
+	QMap<QString, BackgroundInfo> backgroundMap;
+	QMap<QString, QList<FeatureInfo>> featureMap;
+	QMap<QString, FeatInfo> featMap;
+	SpellSlotTable spellSlotTable;
+	SpellCompendium spells;
+	ItemCompendium items;
+};
+
+#endif // REFERENCEDATABASE_H
@@ -0,0 +1,121 @@
+/*
+Name: searchNotes.cpp
+Description: Page to search every character's notes for a word or phrase, opening a result goes straight to
+			 the matching note section.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "searchNotes.h"
+#include "characterIndex.h"
+#include "notesSearchIndex.h"
+
+#include <QElapsedTimer>
+#include <QGridLayout>
+#include <QPushButton>
+#include <QStackedWidget>
+#include <QTimer>
+
+// Roles holding where a result points
+static const int characterRole = Qt::UserRole;
+static const int sectionRole = Qt::UserRole + 1;
+static const int offsetRole = Qt::UserRole + 2;
+static const int lengthRole = Qt::UserRole + 3;
+
+SearchNotes::SearchNotes(QWidget *parent)
+	: QWidget(parent)
+{
+	QGridLayout *layout = new QGridLayout(this);
+
+	// Back button at the top left
+	QPushButton *backButton = new QPushButton("Return to Character Select");
+	layout->addWidget(backButton, 0, 0, Qt::AlignLeft);
+
+	// Search box across the top
+	this->query = new QLineEdit();
+	this->query->setPlaceholderText("Search every character's notes for a word or phrase");
+	this->query->setClearButtonEnabled(true);
+	layout->addWidget(this->query, 1, 0, 1, 2);
+
+	// Number of results and how long the search took
+	this->status = new QLabel();
+	layout->addWidget(this->status, 2, 0, 1, 2);
+
+	// Results, best match first
+	this->results = new QListWidget();
+	layout->addWidget(this->results, 3, 0, 1, 2);
+	layout->setRowStretch(3, 1);
+	layout->setColumnStretch(1, 1);
+
+	connect(backButton, &QPushButton::clicked, this, &SearchNotes::goBack);
+	connect(this->query, &QLineEdit::textChanged, this, &SearchNotes::runSearch);
+	connect(this->results, &QListWidget::itemActivated, this, &SearchNotes::openResult);
+
+	// The index is loaded and checked against the notes once the app is running, not on the first search
+	QTimer::singleShot(0, this, []() { NotesSearchIndex::instance().prepare(); });
+}
+
+void SearchNotes::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+
+	// Notes may have been edited since the page was last shown
+	this->runSearch();
+	this->query->setFocus();
+}
+
+void SearchNotes::runSearch()
+{
+	this->results->clear();
+	QString text = this->query->text().trimmed();
+	if (text.isEmpty())
+	{
+		this->status->clear();
+		return;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	const QList<NotesSearchIndex::Result> found = NotesSearchIndex::instance().search(text);
+	qint64 elapsed = timer.elapsed();
+
+	int shown = 0;
+	for (const NotesSearchIndex::Result &result : found)
+	{
+		// The search index is not told about characters deleted outside of the app
+		if (!CharacterIndex::instance().contains(result.character))
+		{
+			continue;
+		}
+
+		QListWidgetItem *item = new QListWidgetItem(result.character + " - " + result.section);
+		item->setData(characterRole, result.character);
+		item->setData(sectionRole, result.section);
+		item->setData(offsetRole, result.offset);
+		item->setData(lengthRole, result.length);
+		this->results->addItem(item);
+		shown++;
+	}
+
+	this->status->setText(QString("%1 %2 in %3 ms")
+							  .arg(shown)
+							  .arg(shown == 1 ? "note" : "notes")
+							  .arg(elapsed));
+}
+
+void SearchNotes::openResult(QListWidgetItem *item)
+{
+	emit openNote(item->data(characterRole).toString(), item->data(sectionRole).toString(),
+				  item->data(offsetRole).toInt(), item->data(lengthRole).toInt());
+}
+
+void SearchNotes::goBack()
+{
+	QStackedWidget *stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
+	if (stackedWidget)
+	{
+		stackedWidget->setCurrentIndex(0); // character select is at index 0
+	}
+}
@@ -0,0 +1,43 @@
+/*
+Name: searchNotes.h
+Description: Page to search every character's notes for a word or phrase, opening a result goes straight to
+			 the matching note section.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SEARCHNOTES_H
+#define SEARCHNOTES_H
+
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QWidget>
+
+class SearchNotes : public QWidget
+{
+	Q_OBJECT
+public:
+	explicit SearchNotes(QWidget *parent = nullptr);
+
+signals:
+	// A result was opened, offset and length are the matched text within the section
+	void openNote(const QString &character, const QString &section, int offset, int length);
+
+protected:
+	void showEvent(QShowEvent *event) override;
+
+private:
+	QLineEdit *query;
+	QListWidget *results;
+	QLabel *status;
+
+private slots:
+	void runSearch();
+	void openResult(QListWidgetItem *item);
+	void goBack();
+};
+
+#endif // SEARCHNOTES_H
@@ -1,21 +1,26 @@
 /*
 Name: settings.cpp
-Description: Enhanced settings page to allow the user to import characters, switch themes, and return to character select with a structured layout.
+Description: Enhanced settings page to allow the user to import characters, switch themes, pick where characters are stored, set how often notes are saved, and return to character select with a structured layout.
 Authors: Carson Treece, Josh Park
 Other Sources: ...
 Date Created: 10/24/2024
-Last Modified: 11/06/2024
+Last Modified: 10/17/2026
 */
 
 #include "settings.h"
+#include "characterStorage.h"
+#include "autosaveEngine.h"
 #include <QVBoxLayout>
 #include <QPushButton>
 #include <QComboBox>
+#include <QSpinBox>
 #include <QStackedWidget>
 #include <QFile>
 #include <QApplication>
 #include <QGridLayout>
 #include <QSpacerItem>
+#include <QHBoxLayout>
+#include <QLabel>
 
 Settings::Settings(QWidget *parent) :
     QWidget(parent)
@@ -40,18 +45,58 @@ Settings::Settings(QWidget *parent) :
         themeSelector->setCurrentIndex(index);
     }
 
+    // Storage selection below the theme selector, the characters are copied over on the next launch
+    QWidget *storageRow = new QWidget();
+    QHBoxLayout *storageLayout = new QHBoxLayout(storageRow);
+    storageLayout->setContentsMargins(0, 0, 0, 0);
+    QComboBox *storageSelector = new QComboBox();
+    storageSelector->addItem(CharacterStorage::backendName(CharacterStorage::Folders), CharacterStorage::Folders);
+    storageSelector->addItem(CharacterStorage::backendName(CharacterStorage::Campaign), CharacterStorage::Campaign);
+    storageSelector->setCurrentIndex(storageSelector->findData(CharacterStorage::selectedBackend()));
+    QLabel *storageNote = new QLabel("Takes effect the next time the app is started");
+    storageNote->setVisible(false);
+    storageLayout->addWidget(new QLabel("Character Storage:"));
+    storageLayout->addWidget(storageSelector);
+    storageLayout->addWidget(storageNote);
+    mainLayout->addWidget(storageRow, 2, 0, Qt::AlignLeft);
+
+    // Longest a note edit can wait before it is saved, used by notes pages opened after the change
+    QWidget *autosaveRow = new QWidget();
+    QHBoxLayout *autosaveLayout = new QHBoxLayout(autosaveRow);
+    autosaveLayout->setContentsMargins(0, 0, 0, 0);
+    QSpinBox *autosaveSelector = new QSpinBox();
+    autosaveSelector->setRange(5, 600);
+    autosaveSelector->setSuffix(" seconds");
+    autosaveSelector->setValue(AutosaveEngine::savedMaxStaleness());
+    autosaveLayout->addWidget(new QLabel("Save notes at least every:"));
+    autosaveLayout->addWidget(autosaveSelector);
+    mainLayout->addWidget(autosaveRow, 3, 0, Qt::AlignLeft);
+
     // Import button at the bottom left
     QPushButton *importButton = new QPushButton("Import Character");
-    mainLayout->addWidget(importButton, 2, 0, Qt::AlignLeft);
+    mainLayout->addWidget(importButton, 4, 0, Qt::AlignLeft);
 
     // Add some vertical spacing around the components
     mainLayout->setRowStretch(0, 1); // Stretch space above back button
     mainLayout->setRowStretch(1, 3); // Stretch space around theme selector
-    mainLayout->setRowStretch(2, 2); // Stretch space around import button
+    mainLayout->setRowStretch(2, 1); // Stretch space around storage selector
+    mainLayout->setRowStretch(3, 1); // Stretch space around autosave interval
+    mainLayout->setRowStretch(4, 2); // Stretch space around import button
 
     // Connect theme selector to change styles
     connect(themeSelector, &QComboBox::currentTextChanged, this, &Settings::changeTheme);
 
+    // Save the selected storage, the open one keeps being used until the app is restarted
+    connect(storageSelector, QOverload<int>::of(&QComboBox::currentIndexChanged), [storageSelector, storageNote](int index) {
+        CharacterStorage::Backend backend = static_cast<CharacterStorage::Backend>(storageSelector->itemData(index).toInt());
+        CharacterStorage::setSelectedBackend(backend);
+        storageNote->setVisible(backend != CharacterStorage::instance().backend());
+    });
+
+    connect(autosaveSelector, QOverload<int>::of(&QSpinBox::valueChanged), [](int seconds) {
+        AutosaveEngine::setSavedMaxStaleness(seconds);
+    });
+
     // Connect the back button to navigate to the character select page
     connect(backButton, &QPushButton::clicked, [this]() {
         QStackedWidget *stackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
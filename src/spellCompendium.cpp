@@ -0,0 +1,272 @@
+/*
+Name: spellCompendium.cpp
+Description: Every spell in Spells.tsv held in memory and indexed by name, level, school, class,
+			 concentration and ritual, so the add spell dialogs pick spells instead of typing them in and
+			 a character's spells.csv only has to name them.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellCompendium.h"
+#include "databaseSnapshot.h"
+
+#include <QDebug>
+#include <QSet>
+#include <algorithm>
+#include <numeric>
+
+void SpellCompendium::load(const DatabaseSnapshot &snapshot)
+{
+	QVector<SpellRecord> spells;
+	QVector<QStringList> classes;
+	for (int i = 0; i < snapshot.rowCount("Spells.tsv"); i++)
+	{
+		const DatabaseSnapshot::Row fields = snapshot.row("Spells.tsv", i);
+		if (fields.size() < 13)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		SpellRecord spell;
+		spell.name = fields[0].toString();
+		spell.book = fields[1].toString();
+		spell.page = fields[2].toString();
+		spell.level = qBound(0, fields[3].toInt(), int(SpellSlotTable::maxSpellLevel));
+		spell.school = fields[4].toString();
+		spell.castingTime = fields[5].toString();
+		spell.range = fields[6].toString();
+		QString components = fields[7].toString().toLower();
+		spell.verbal = components.contains("v");
+		spell.somatic = components.contains("s");
+		spell.material = components.contains("m");
+		spell.duration = fields[8].toString();
+		spell.concentration = SpellRecord::readFlag(fields[9].toString());
+		spell.ritual = SpellRecord::readFlag(fields[10].toString());
+		spell.description = fields[12].toString();
+		spells.append(spell);
+		classes.append(fields[11].toString().split(", ", Qt::SkipEmptyParts));
+	}
+
+	// Number the spells in name order
+	QVector<int> order(spells.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&spells](int a, int b) {
+		return spells[a].name.toLower() < spells[b].name.toLower();
+	});
+
+	for (int i : order)
+	{
+		QString key = spells[i].name.toLower();
+		if (this->nameIndex.contains(key))
+		{
+			qWarning() << "Spells.tsv has" << spells[i].name << "more than once, keeping the first";
+			continue;
+		}
+
+		int id = this->entries.size();
+		const SpellRecord &spell = spells[i];
+		this->entries.append(spell);
+		this->classLists.append(classes[i]);
+		this->lowerNames.append(key);
+		this->nameIndex.insert(key, id);
+		this->allIds.append(id);
+		this->levelIndex[spell.level].append(id);
+		this->schoolIndex[spell.school.toLower()].append(id);
+		for (const QString &className : classes[i])
+		{
+			this->classIndex[className.toLower()].append(id);
+		}
+		if (spell.concentration)
+		{
+			this->concentrationIndex.append(id);
+		}
+		if (spell.ritual)
+		{
+			this->ritualIndex.append(id);
+		}
+	}
+
+	QStringList names;
+	for (const SpellRecord &spell : this->entries)
+	{
+		names.append(spell.name);
+	}
+	this->nameMatcher.setEntries(names);
+}
+
+int SpellCompendium::find(const QString &name) const
+{
+	return this->nameIndex.value(name.trimmed().toLower(), -1);
+}
+
+QVector<int> SpellCompendium::query(const Query &query) const
+{
+	// Start from the narrowest index the query uses and check the rest of the query on each of its spells
+	const QVector<int> *candidates = &this->allIds;
+	auto narrow = [&candidates](const QVector<int> *ids) {
+		if (ids->size() < candidates->size())
+		{
+			candidates = ids;
+		}
+	};
+
+	static const QVector<int> none;
+	QVector<int> prefixIds;
+	if (!query.namePrefix.isEmpty())
+	{
+		QString prefix = query.namePrefix.toLower();
+		auto first = std::lower_bound(this->lowerNames.cbegin(), this->lowerNames.cend(), prefix);
+		for (auto it = first; it != this->lowerNames.cend() && it->startsWith(prefix); ++it)
+		{
+			prefixIds.append(int(it - this->lowerNames.cbegin()));
+		}
+		candidates = &prefixIds;
+	}
+	if (query.level >= 0)
+	{
+		narrow(query.level <= SpellSlotTable::maxSpellLevel ? &this->levelIndex[query.level] : &none);
+	}
+	if (!query.school.isEmpty())
+	{
+		auto it = this->schoolIndex.constFind(query.school.toLower());
+		narrow(it == this->schoolIndex.constEnd() ? &none : &it.value());
+	}
+	if (!query.className.isEmpty())
+	{
+		auto it = this->classIndex.constFind(query.className.toLower());
+		narrow(it == this->classIndex.constEnd() ? &none : &it.value());
+	}
+	if (query.concentration == 1)
+	{
+		narrow(&this->concentrationIndex);
+	}
+	if (query.ritual == 1)
+	{
+		narrow(&this->ritualIndex);
+	}
+
+	QVector<int> ids;
+	for (int id : *candidates)
+	{
+		if (this->matches(id, query))
+		{
+			ids.append(id);
+		}
+	}
+	return ids;
+}
+
+QVector<int> SpellCompendium::search(const QString &text, const Query &query, int limit) const
+{
+	if (text.trimmed().isEmpty())
+	{
+		return this->query(query);
+	}
+
+	// Ask for more names than needed since the rest of the query may leave some of them out
+	QVector<int> ids;
+	for (const FuzzyMatcher::Match &match : this->nameMatcher.match(text, qMax(limit * 4, 200)))
+	{
+		if (this->matches(match.index, query))
+		{
+			ids.append(match.index);
+			if (ids.size() == limit)
+			{
+				break;
+			}
+		}
+	}
+	return ids;
+}
+
+bool SpellCompendium::matches(int id, const Query &query) const
+{
+	const SpellRecord &spell = this->entries[id];
+	return (query.namePrefix.isEmpty() || spell.name.startsWith(query.namePrefix, Qt::CaseInsensitive)) &&
+		   (query.level < 0 || spell.level == query.level) &&
+		   (query.school.isEmpty() || spell.school.compare(query.school, Qt::CaseInsensitive) == 0) &&
+		   (query.concentration < 0 || spell.concentration == bool(query.concentration)) &&
+		   (query.ritual < 0 || spell.ritual == bool(query.ritual)) &&
+		   (query.className.isEmpty() || this->classLists[id].contains(query.className, Qt::CaseInsensitive));
+}
+
+QStringList SpellCompendium::schools() const
+{
+	QStringList names;
+	for (const SpellRecord &spell : this->entries)
+	{
+		if (!names.contains(spell.school))
+		{
+			names.append(spell.school);
+		}
+	}
+	names.sort(Qt::CaseInsensitive);
+	return names;
+}
+
+QStringList SpellCompendium::classNames() const
+{
+	QSet<QString> seen;
+	QStringList names;
+	for (const QStringList &classes : this->classLists)
+	{
+		for (const QString &className : classes)
+		{
+			if (!seen.contains(className))
+			{
+				seen.insert(className);
+				names.append(className);
+			}
+		}
+	}
+	names.sort(Qt::CaseInsensitive);
+	return names;
+}
+
+SpellRecord SpellCompendium::read(const QString &line, bool *ok) const
+{
+	QStringList fields = line.split(",");
+	if (fields.size() != 2)
+	{
+		return SpellRecord::fromLine(line, ok);
+	}
+
+	if (ok)
+	{
+		*ok = !fields[0].trimmed().isEmpty();
+	}
+	int id = this->find(fields[0]);
+	SpellRecord spell;
+	if (id >= 0)
+	{
+		spell = this->entries[id];
+	}
+	else
+	{
+		// Keep the name so the spell is not lost if it was taken out of Spells.tsv
+		qWarning() << "Spell" << fields[0] << "is not in Spells.tsv";
+		spell.name = fields[0].trimmed();
+	}
+	spell.prepared = SpellRecord::readFlag(fields[1].trimmed());
+	return spell;
+}
+
+QString SpellCompendium::write(const SpellRecord &spell) const
+{
+	int id = this->find(spell.name);
+	if (id < 0)
+	{
+		return spell.toLine();
+	}
+
+	// Only a spell that still matches the compendium is shortened, edits to any field are kept in full
+	SpellRecord entry = this->entries[id];
+	entry.prepared = spell.prepared;
+	if (entry.toLine() != spell.toLine())
+	{
+		return spell.toLine();
+	}
+	return entry.name + "," + (spell.prepared ? "1" : "0");
+}
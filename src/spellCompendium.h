@@ -0,0 +1,77 @@
+/*
+Name: spellCompendium.h
+Description: Every spell in Spells.tsv held in memory and indexed by name, level, school, class,
+			 concentration and ritual, so the add spell dialogs pick spells instead of typing them in and
+			 a character's spells.csv only has to name them.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLCOMPENDIUM_H
+#define SPELLCOMPENDIUM_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "fuzzyMatcher.h"
+#include "spellRecord.h"
+#include "spellSlotTable.h"
+
+class DatabaseSnapshot;
+
+class SpellCompendium
+{
+public:
+	// Empty strings and -1 match everything
+	struct Query
+	{
+		QString namePrefix;
+		int level = -1;
+		QString school;
+		QString className;
+		int concentration = -1;
+		int ritual = -1;
+	};
+
+	void load(const DatabaseSnapshot &snapshot);
+
+	// Spells are numbered in name order, so every list of ids is also alphabetical
+	int size() const { return this->entries.size(); }
+	const SpellRecord &spell(int id) const { return this->entries[id]; }
+	const QStringList &classes(int id) const { return this->classLists[id]; }
+	// Case-insensitive, -1 if the spell is not in Spells.tsv
+	int find(const QString &name) const;
+	QVector<int> query(const Query &query) const;
+	// Spells whose names fuzzily match text, best first, that also match the query
+	QVector<int> search(const QString &text, const Query &query, int limit = 100) const;
+
+	// School and class names in alphabetical order
+	QStringList schools() const;
+	QStringList classNames() const;
+
+	// Lines of spells.csv. A spell from the compendium is stored as just "name,prepared" and filled in on
+	// reading, anything else (homebrew or edited spells) keeps the full SpellRecord line
+	SpellRecord read(const QString &line, bool *ok = nullptr) const;
+	QString write(const SpellRecord &spell) const;
+
+private:
+	bool matches(int id, const Query &query) const;
+
+	QVector<SpellRecord> entries;
+	QVector<QStringList> classLists;
+	QVector<QString> lowerNames; // sorted, so a name prefix is a binary search
+	QHash<QString, int> nameIndex; // lowercase name to id
+	QVector<int> levelIndex[SpellSlotTable::maxSpellLevel + 1];
+	QHash<QString, QVector<int>> schoolIndex; // lowercase school to ids
+	QHash<QString, QVector<int>> classIndex; // lowercase class to ids
+	QVector<int> concentrationIndex;
+	QVector<int> ritualIndex;
+	QVector<int> allIds;
+	FuzzyMatcher nameMatcher; // entries are the spell names in id order
+};
+
+#endif // SPELLCOMPENDIUM_H
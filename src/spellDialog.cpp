@@ -0,0 +1,411 @@
+/*
+Name: spellDialog.cpp
+Description: Dialog for learning spells from the spell compendium, shared by character creation, the
+			 character page's level up and the spells page. Choosing a spell fills in its whole record, and
+			 homebrew spells or ones missing from the compendium are entered as custom spells.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellDialog.h"
+#include "referenceDatabase.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+static QString levelName(int level)
+{
+	static const QStringList names = {"Cantrip", "1st Level", "2nd Level", "3rd Level", "4th Level",
+									  "5th Level", "6th Level", "7th Level", "8th Level", "9th Level"};
+	return names.value(level);
+}
+
+// Spells are saved one comma separated line each, only the description may hold commas
+static QString field(const QString &text)
+{
+	return text.trimmed().replace(",", ";");
+}
+
+SpellDialog::SpellDialog(int count, const QString &className, int characterLevel, const QStringList &known,
+						 QWidget *parent)
+	: QDialog(parent), count(qMax(1, count)), maxLevel(highestSpellLevel(className, characterLevel))
+{
+	for (const QString &name : known)
+	{
+		this->known.insert(name.trimmed().toLower());
+	}
+
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+
+	this->setWindowModality(Qt::ApplicationModal); // stops the user from interacting with the main window while the popup is open
+	this->setWindowTitle(this->count == 1 ? "Add Spell" : "Add Spells");
+
+	this->header = new QLabel();
+
+	this->search = new QLineEdit();
+	this->search->setPlaceholderText("Spell name");
+
+	this->classFilter = new QComboBox();
+	this->classFilter->addItem("All Classes", QString());
+	for (const QString &name : compendium.classNames())
+	{
+		this->classFilter->addItem(name, name);
+	}
+	int classIndex = this->classFilter->findData(className);
+	this->classFilter->setCurrentIndex(classIndex >= 0 ? classIndex : 0);
+
+	this->levelFilter = new QComboBox();
+	this->levelFilter->addItem("Any Level", -1);
+	for (int level = 0; level <= this->maxLevel; level++)
+	{
+		this->levelFilter->addItem(levelName(level), level);
+	}
+
+	this->schoolFilter = new QComboBox();
+	this->schoolFilter->addItem("All Schools", QString());
+	for (const QString &school : compendium.schools())
+	{
+		this->schoolFilter->addItem(school, school);
+	}
+
+	this->concentrationFilter = new QCheckBox("Concentration");
+	this->ritualFilter = new QCheckBox("Ritual");
+
+	this->results = new QListWidget();
+	this->details = new QLabel();
+	this->details->setWordWrap(true);
+	this->details->setAlignment(Qt::AlignTop | Qt::AlignLeft);
+	this->details->setMinimumWidth(300);
+
+	// create the buttons for the popup
+	this->confirm = new QPushButton("Confirm");
+	QPushButton *cancel = new QPushButton("Cancel");
+	QPushButton *customButton = new QPushButton("Custom Spell...");
+
+	// Gets rid of the padding around the text of the buttons
+	this->confirm->setStyleSheet("padding: 5px 0px; margin: 0px;");
+	cancel->setStyleSheet("padding: 5px 0px; margin: 0px;");
+	customButton->setStyleSheet("padding: 5px 0px; margin: 0px;");
+
+	QGridLayout *filterLayout = new QGridLayout();
+	filterLayout->addWidget(this->search, 0, 0, 1, 3);
+	filterLayout->addWidget(this->classFilter, 1, 0);
+	filterLayout->addWidget(this->levelFilter, 1, 1);
+	filterLayout->addWidget(this->schoolFilter, 1, 2);
+	filterLayout->addWidget(this->concentrationFilter, 2, 0);
+	filterLayout->addWidget(this->ritualFilter, 2, 1);
+
+	QHBoxLayout *bodyLayout = new QHBoxLayout();
+	bodyLayout->addWidget(this->results, 1);
+	bodyLayout->addWidget(this->details, 1);
+
+	QHBoxLayout *buttonLayout = new QHBoxLayout();
+	buttonLayout->addWidget(customButton);
+	buttonLayout->addWidget(this->confirm);
+	buttonLayout->addWidget(cancel);
+
+	QVBoxLayout *layout = new QVBoxLayout(this);
+	layout->addWidget(this->header);
+	layout->addLayout(filterLayout);
+	layout->addLayout(bodyLayout, 1);
+	layout->addLayout(buttonLayout);
+
+	connect(this->confirm, &QPushButton::clicked, this, &QDialog::accept);
+	connect(cancel, &QPushButton::clicked, this, &QDialog::reject);
+	connect(customButton, &QPushButton::clicked, this, &SpellDialog::addCustomSpell);
+	connect(this->search, SIGNAL(textChanged(QString)), SLOT(updateResults()));
+	connect(this->classFilter, SIGNAL(currentIndexChanged(int)), SLOT(updateResults()));
+	connect(this->levelFilter, SIGNAL(currentIndexChanged(int)), SLOT(updateResults()));
+	connect(this->schoolFilter, SIGNAL(currentIndexChanged(int)), SLOT(updateResults()));
+	connect(this->concentrationFilter, SIGNAL(toggled(bool)), SLOT(updateResults()));
+	connect(this->ritualFilter, SIGNAL(toggled(bool)), SLOT(updateResults()));
+	connect(this->results, SIGNAL(itemChanged(QListWidgetItem *)), SLOT(toggleSpell(QListWidgetItem *)));
+	connect(this->results, SIGNAL(currentItemChanged(QListWidgetItem *, QListWidgetItem *)),
+			SLOT(showSpell(QListWidgetItem *)));
+
+	this->resize(800, 500);
+	this->updateResults();
+	this->updateHeader();
+}
+
+QVector<SpellRecord> SpellDialog::chosenSpells() const
+{
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+	QList<int> ids = this->chosen.values();
+	std::sort(ids.begin(), ids.end());
+
+	QVector<SpellRecord> spells;
+	for (int id : ids)
+	{
+		if (id >= 0)
+		{
+			spells.append(compendium.spell(id));
+		}
+	}
+	for (int i = 0; i < this->custom.size(); i++)
+	{
+		if (this->chosen.contains(-1 - i))
+		{
+			spells.append(this->custom[i]);
+		}
+	}
+	return spells;
+}
+
+void SpellDialog::updateResults()
+{
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+
+	SpellCompendium::Query query;
+	query.level = this->levelFilter->currentData().toInt();
+	query.school = this->schoolFilter->currentData().toString();
+	query.className = this->classFilter->currentData().toString();
+	query.concentration = this->concentrationFilter->isChecked() ? 1 : -1;
+	query.ritual = this->ritualFilter->isChecked() ? 1 : -1;
+
+	// Rebuilding the items would report every check state as a change
+	this->results->blockSignals(true);
+	this->results->clear();
+	// Custom spells were entered by hand, they always stay at the top of the list
+	for (int i = 0; i < this->custom.size(); i++)
+	{
+		this->results->addItem(this->itemFor(-1 - i, this->custom[i]));
+	}
+	// Names are matched fuzzily and best first, so a typo or part of a later word still finds the spell
+	for (int id : compendium.search(this->search->text(), query, compendium.size()))
+	{
+		const SpellRecord &spell = compendium.spell(id);
+		if (spell.level > this->maxLevel || this->known.contains(spell.name.toLower()))
+		{
+			continue;
+		}
+
+		this->results->addItem(this->itemFor(id, spell));
+	}
+	this->results->blockSignals(false);
+	this->details->clear();
+}
+
+void SpellDialog::toggleSpell(QListWidgetItem *item)
+{
+	int id = item->data(Qt::UserRole).toInt();
+	if (item->checkState() != Qt::Checked)
+	{
+		this->chosen.remove(id);
+		this->updateHeader();
+		return;
+	}
+
+	// With one spell to choose, choosing another replaces it
+	if (this->count == 1 && !this->chosen.isEmpty())
+	{
+		this->chosen.clear();
+		this->results->blockSignals(true);
+		for (int row = 0; row < this->results->count(); row++)
+		{
+			QListWidgetItem *other = this->results->item(row);
+			if (other != item)
+			{
+				other->setCheckState(Qt::Unchecked);
+			}
+		}
+		this->results->blockSignals(false);
+	}
+	this->chosen.insert(id);
+	this->results->setCurrentItem(item);
+	this->updateHeader();
+}
+
+void SpellDialog::showSpell(QListWidgetItem *item)
+{
+	if (!item)
+	{
+		this->details->clear();
+		return;
+	}
+	this->details->setText(describe(this->spellFor(item->data(Qt::UserRole).toInt())));
+}
+
+/**
+ * This function asks for every field of a spell that is not in the compendium, the spell is added to the
+ * top of the list already chosen
+ */
+void SpellDialog::addCustomSpell()
+{
+	QDialog form(this);
+	form.setWindowTitle("Custom Spell");
+
+	QLineEdit *name = new QLineEdit();
+	QSpinBox *level = new QSpinBox();
+	level->setRange(0, SpellSlotTable::maxSpellLevel);
+	level->setSpecialValueText(levelName(0));
+	QComboBox *school = new QComboBox();
+	school->setEditable(true);
+	school->addItems(ReferenceDatabase::instance().spellCompendium().schools());
+	QLineEdit *castingTime = new QLineEdit("1 action");
+	QLineEdit *range = new QLineEdit();
+	QCheckBox *verbal = new QCheckBox("Verbal");
+	QCheckBox *somatic = new QCheckBox("Somatic");
+	QCheckBox *material = new QCheckBox("Material");
+	QLineEdit *duration = new QLineEdit("Instantaneous");
+	QCheckBox *concentration = new QCheckBox("Concentration");
+	QCheckBox *ritual = new QCheckBox("Ritual");
+	QLineEdit *book = new QLineEdit("Homebrew");
+	QLineEdit *page = new QLineEdit();
+	QPlainTextEdit *description = new QPlainTextEdit();
+
+	QHBoxLayout *components = new QHBoxLayout();
+	components->addWidget(verbal);
+	components->addWidget(somatic);
+	components->addWidget(material);
+	QHBoxLayout *flags = new QHBoxLayout();
+	flags->addWidget(concentration);
+	flags->addWidget(ritual);
+
+	QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+	buttons->button(QDialogButtonBox::Ok)->setEnabled(false);
+
+	QFormLayout *layout = new QFormLayout(&form);
+	layout->addRow("Name:", name);
+	layout->addRow("Level:", level);
+	layout->addRow("School:", school);
+	layout->addRow("Casting Time:", castingTime);
+	layout->addRow("Range:", range);
+	layout->addRow("Components:", components);
+	layout->addRow("Duration:", duration);
+	layout->addRow("", flags);
+	layout->addRow("Source:", book);
+	layout->addRow("Page:", page);
+	layout->addRow("Description:", description);
+	layout->addRow(buttons);
+
+	connect(buttons, &QDialogButtonBox::accepted, &form, &QDialog::accept);
+	connect(buttons, &QDialogButtonBox::rejected, &form, &QDialog::reject);
+	connect(name, &QLineEdit::textChanged, &form, [buttons](const QString &text) {
+		buttons->button(QDialogButtonBox::Ok)->setEnabled(!text.trimmed().isEmpty());
+	});
+
+	if (form.exec() != QDialog::Accepted)
+	{
+		return;
+	}
+
+	SpellRecord spell;
+	spell.name = field(name->text());
+	spell.level = level->value();
+	spell.school = field(school->currentText());
+	spell.castingTime = field(castingTime->text());
+	spell.range = field(range->text());
+	spell.verbal = verbal->isChecked();
+	spell.somatic = somatic->isChecked();
+	spell.material = material->isChecked();
+	spell.duration = field(duration->text());
+	spell.concentration = concentration->isChecked();
+	spell.ritual = ritual->isChecked();
+	spell.book = field(book->text());
+	spell.page = field(page->text());
+	spell.description = description->toPlainText().trimmed().replace("\n", "<br>");
+	this->custom.append(spell);
+
+	// Chosen the same way as ticking it in the list, so one spell to choose replaces any other choice
+	this->updateResults();
+	QListWidgetItem *item = this->results->item(this->custom.size() - 1);
+	item->setCheckState(Qt::Checked);
+}
+
+void SpellDialog::updateHeader()
+{
+	QString text = this->count == 1 ? QString("<h3>Choose a spell</h3>")
+									: QString("<h3>Choose up to %1 spells, %2 chosen</h3>").arg(this->count).arg(this->chosen.size());
+	if (this->chosen.size() > this->count)
+	{
+		text += "Too many spells chosen";
+	}
+	this->header->setText(text);
+	this->confirm->setEnabled(!this->chosen.isEmpty() && this->chosen.size() <= this->count);
+}
+
+SpellRecord SpellDialog::spellFor(int id) const
+{
+	if (id < 0)
+	{
+		return this->custom.value(-1 - id);
+	}
+	return ReferenceDatabase::instance().spellCompendium().spell(id);
+}
+
+QListWidgetItem *SpellDialog::itemFor(int id, const SpellRecord &spell) const
+{
+	QListWidgetItem *item = new QListWidgetItem(spell.name + " (" + levelName(spell.level) + ")");
+	item->setData(Qt::UserRole, id);
+	item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+	item->setCheckState(this->chosen.contains(id) ? Qt::Checked : Qt::Unchecked);
+	return item;
+}
+
+int SpellDialog::highestSpellLevel(const QString &className, int characterLevel)
+{
+	const SpellSlotTable &slots = ReferenceDatabase::instance().spellSlots();
+	if (className.isEmpty() || characterLevel <= 0 || slots.classIndex(className) < 0)
+	{
+		return SpellSlotTable::maxSpellLevel;
+	}
+
+	SpellSlotTable::Slots classSlots = slots.isPactCaster(className) ? slots.pactSlots(characterLevel)
+																	 : slots.slotsFor(className, characterLevel);
+	int highest = 0;
+	for (int level = 1; level <= SpellSlotTable::maxSpellLevel; level++)
+	{
+		if (classSlots.count[level] > 0)
+		{
+			highest = level;
+		}
+	}
+	return highest;
+}
+
+QString SpellDialog::describe(const SpellRecord &spell)
+{
+	QStringList components;
+	if (spell.verbal)
+	{
+		components.append("V");
+	}
+	if (spell.somatic)
+	{
+		components.append("S");
+	}
+	if (spell.material)
+	{
+		components.append("M");
+	}
+
+	QString type = spell.level == 0 ? spell.school + " cantrip" : levelName(spell.level) + " " + spell.school;
+	if (spell.ritual)
+	{
+		type += " (ritual)";
+	}
+
+	return "<h3>" + spell.name.toHtmlEscaped() + "</h3><i>" + type.toHtmlEscaped() + ", " +
+		   spell.book.toHtmlEscaped() + " " + spell.page.toHtmlEscaped() + "</i><br><br>" +
+		   "<b>Casting Time:</b> " + spell.castingTime.toHtmlEscaped() + "<br>" +
+		   "<b>Range:</b> " + spell.range.toHtmlEscaped() + "<br>" +
+		   "<b>Components:</b> " + components.join(", ") + "<br>" +
+		   "<b>Duration:</b> " + spell.duration.toHtmlEscaped() + "<br><br>" +
+		   spell.description.toHtmlEscaped().replace("&lt;br&gt;", "<br>");
+}
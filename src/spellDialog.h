@@ -0,0 +1,74 @@
+/*
+Name: spellDialog.h
+Description: Dialog for learning spells from the spell compendium, shared by character creation, the
+			 character page's level up and the spells page. Choosing a spell fills in its whole record, and
+			 homebrew spells or ones missing from the compendium are entered as custom spells.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLDIALOG_H
+#define SPELLDIALOG_H
+
+#include <QDialog>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+#include "spellRecord.h"
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QListWidget;
+class QListWidgetItem;
+class QPushButton;
+
+class SpellDialog : public QDialog
+{
+	Q_OBJECT
+public:
+	// Lets the user choose up to count spells. The class and character level start the list on the
+	// class's spells and leave out levels the character has no slots for, spells already in known are hidden
+	explicit SpellDialog(int count, const QString &className = QString(), int characterLevel = 0,
+						 const QStringList &known = QStringList(), QWidget *parent = nullptr);
+
+	// The chosen spells in name order, not prepared, custom spells after the compendium's
+	QVector<SpellRecord> chosenSpells() const;
+
+private slots:
+	void updateResults();
+	void toggleSpell(QListWidgetItem *item);
+	void showSpell(QListWidgetItem *item);
+	void addCustomSpell();
+
+private:
+	static int highestSpellLevel(const QString &className, int characterLevel);
+	static QString describe(const SpellRecord &spell);
+	void updateHeader();
+	// Compendium spells have their id, custom spells are numbered -1, -2, ...
+	SpellRecord spellFor(int id) const;
+	QListWidgetItem *itemFor(int id, const SpellRecord &spell) const;
+
+	int count;
+	int maxLevel;
+	QSet<QString> known; // lowercase names
+	QSet<int> chosen; // compendium ids, and negative ids for custom spells
+	QVector<SpellRecord> custom;
+
+	QLabel *header;
+	QLineEdit *search;
+	QComboBox *classFilter;
+	QComboBox *levelFilter;
+	QComboBox *schoolFilter;
+	QCheckBox *concentrationFilter;
+	QCheckBox *ritualFilter;
+	QListWidget *results;
+	QLabel *details;
+	QPushButton *confirm;
+};
+
+#endif // SPELLDIALOG_H
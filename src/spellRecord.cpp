@@ -0,0 +1,75 @@
+/*
+Name: spellRecord.cpp
+Description: One line of a character's spells.csv as a plain struct, with the conversion to and from the
+			 comma separated line.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellRecord.h"
+
+#include <QStringList>
+
+static const int fieldCount = 13;
+
+SpellRecord SpellRecord::fromLine(const QString &line, bool *ok)
+{
+	SpellRecord spell;
+	QStringList fields = line.split(",");
+	if (ok)
+	{
+		*ok = fields.size() >= fieldCount;
+	}
+	if (fields.size() < fieldCount)
+	{
+		return spell;
+	}
+
+	spell.name = fields[0];
+	spell.book = fields[1];
+	spell.page = fields[2];
+	spell.level = fields[3].toInt();
+	spell.school = fields[4];
+	spell.castingTime = fields[5];
+	spell.range = fields[6];
+	spell.verbal = fields[7].contains("v");
+	spell.somatic = fields[7].contains("s");
+	spell.material = fields[7].contains("m");
+	spell.duration = fields[8];
+	spell.concentration = readFlag(fields[9]);
+	spell.ritual = readFlag(fields[10]);
+	spell.prepared = readFlag(fields[11]);
+	// The description is last, so any commas in it belong to it
+	spell.description = fields.mid(fieldCount - 1).join(",");
+	return spell;
+}
+
+bool SpellRecord::readFlag(const QString &value)
+{
+	return value == "1" || value.compare("true", Qt::CaseInsensitive) == 0;
+}
+
+QString SpellRecord::toLine() const
+{
+	QString components;
+	if (this->verbal)
+	{
+		components += "v";
+	}
+	if (this->somatic)
+	{
+		components += "s";
+	}
+	if (this->material)
+	{
+		components += "m";
+	}
+
+	return QStringList{this->name, this->book, this->page, QString::number(this->level), this->school,
+					   this->castingTime, this->range, components, this->duration,
+					   this->concentration ? "1" : "0", this->ritual ? "1" : "0", this->prepared ? "1" : "0",
+					   this->description}
+		.join(",");
+}
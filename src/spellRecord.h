@@ -0,0 +1,42 @@
+/*
+Name: spellRecord.h
+Description: One line of a character's spells.csv as a plain struct, with the conversion to and from the
+			 comma separated line.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLRECORD_H
+#define SPELLRECORD_H
+
+#include <QString>
+
+struct SpellRecord
+{
+	QString name;
+	QString book;
+	QString page;
+	int level = 0;
+	QString school;
+	QString castingTime;
+	QString range;
+	bool verbal = false;
+	bool somatic = false;
+	bool material = false;
+	QString duration;
+	bool concentration = false;
+	bool ritual = false;
+	bool prepared = false;
+	QString description; // line breaks are kept as <br> so the record stays on one line
+
+	// Reads name,book,page,level,school,time,range,components,duration,concentration,ritual,prepared,description
+	static SpellRecord fromLine(const QString &line, bool *ok = nullptr);
+	QString toLine() const;
+
+	// Spells have been saved with 1/0 and with true/false
+	static bool readFlag(const QString &value);
+};
+
+#endif // SPELLRECORD_H
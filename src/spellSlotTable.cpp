@@ -0,0 +1,144 @@
+/*
+Name: spellSlotTable.cpp
+Description: Dense [class][character level][spell level] table of spell slots from SpellSlots.csv,
+			 including Warlock pact slots and multiclass caster levels.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellSlotTable.h"
+#include "databaseSnapshot.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+static const QStringList fullCasters = {"Bard", "Cleric", "Druid", "Sorcerer", "Wizard"};
+static const QStringList halfCasters = {"Paladin", "Ranger"};
+
+/**
+ * This function fills the table from the SpellSlots.csv rows, ex. Bard,1,2,0,0,0,0,0,0,0,0
+ */
+void SpellSlotTable::load(const DatabaseSnapshot &snapshot)
+{
+	const int rowCount = snapshot.rowCount("SpellSlots.csv");
+
+	// Give every class a block of the table in the order it first appears
+	for (int row = 0; row < rowCount; row++)
+	{
+		QString className = snapshot.row("SpellSlots.csv", row)[0].toString();
+		if (!this->classIndices.contains(className))
+		{
+			this->classIndices.insert(className, this->classIndices.size());
+		}
+	}
+	this->table.fill(0, this->classIndices.size() * maxCharacterLevel * maxSpellLevel);
+
+	for (int row = 0; row < rowCount; row++)
+	{
+		const DatabaseSnapshot::Row fields = snapshot.row("SpellSlots.csv", row);
+		if (fields.size() < 2 + maxSpellLevel)
+		{
+			continue; // ensure we get all the fields
+		}
+
+		int level = fields[1].toInt();
+		if (level < 1 || level > maxCharacterLevel)
+		{
+			continue;
+		}
+
+		int index = this->classIndex(fields[0].toString());
+		for (int spellLevel = 1; spellLevel <= maxSpellLevel; spellLevel++)
+		{
+			this->table[offset(index, level, spellLevel)] = quint8(fields[1 + spellLevel].toInt());
+		}
+	}
+
+	// Every full caster shares the same progression, it doubles as the multiclass table
+	this->casterLevelTable.fill(0, maxCharacterLevel * maxSpellLevel);
+	for (const QString &className : fullCasters)
+	{
+		int index = this->classIndex(className);
+		if (index >= 0)
+		{
+			std::copy(this->table.cbegin() + offset(index, 1, 1),
+					  this->table.cbegin() + offset(index + 1, 1, 1),
+					  this->casterLevelTable.begin());
+			break;
+		}
+	}
+}
+
+int SpellSlotTable::count(int classIndex, int characterLevel, int spellLevel) const
+{
+	if (classIndex < 0 || classIndex >= this->classIndices.size() ||
+		characterLevel < 1 || characterLevel > maxCharacterLevel ||
+		spellLevel < 1 || spellLevel > maxSpellLevel)
+	{
+		return 0;
+	}
+	return this->table[offset(classIndex, characterLevel, spellLevel)];
+}
+
+SpellSlotTable::Slots SpellSlotTable::slotsFor(const QString &className, int characterLevel) const
+{
+	Slots result;
+	int index = this->classIndex(className);
+	for (int spellLevel = 1; spellLevel <= maxSpellLevel; spellLevel++)
+	{
+		result.count[spellLevel] = this->count(index, characterLevel, spellLevel);
+	}
+	return result;
+}
+
+int SpellSlotTable::casterLevel(const QMap<QString, int> &classLevels) const
+{
+	int level = 0;
+	for (auto it = classLevels.cbegin(); it != classLevels.cend(); ++it)
+	{
+		if (fullCasters.contains(it.key()))
+		{
+			level += it.value();
+		}
+		else if (halfCasters.contains(it.key()))
+		{
+			level += it.value() / 2; // rounded down
+		}
+	}
+	return qMin(level, int(maxCharacterLevel));
+}
+
+SpellSlotTable::Slots SpellSlotTable::multiclassSlots(const QMap<QString, int> &classLevels) const
+{
+	// Pact Magic slots are not shared, so Warlock levels are left out here
+	QString onlyCaster;
+	int casterClasses = 0;
+	for (auto it = classLevels.cbegin(); it != classLevels.cend(); ++it)
+	{
+		if (this->classIndex(it.key()) >= 0 && !this->isPactCaster(it.key()) && it.value() > 0)
+		{
+			onlyCaster = it.key();
+			casterClasses++;
+		}
+	}
+
+	if (casterClasses == 1)
+	{
+		return this->slotsFor(onlyCaster, classLevels.value(onlyCaster));
+	}
+
+	Slots result;
+	int level = this->casterLevel(classLevels);
+	if (level < 1)
+	{
+		return result;
+	}
+	for (int spellLevel = 1; spellLevel <= maxSpellLevel; spellLevel++)
+	{
+		result.count[spellLevel] = this->casterLevelTable[offset(0, level, spellLevel)];
+	}
+	return result;
+}
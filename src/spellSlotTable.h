@@ -0,0 +1,63 @@
+/*
+Name: spellSlotTable.h
+Description: Dense [class][character level][spell level] table of spell slots from SpellSlots.csv,
+			 including Warlock pact slots and multiclass caster levels.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLSLOTTABLE_H
+#define SPELLSLOTTABLE_H
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+class DatabaseSnapshot;
+
+class SpellSlotTable
+{
+public:
+	static constexpr int maxCharacterLevel = 20;
+	static constexpr int maxSpellLevel = 9;
+
+	// Slot counts indexed by spell level, count[0] is unused so count[1] is 1st level slots
+	struct Slots
+	{
+		int count[maxSpellLevel + 1] = {};
+	};
+
+	void load(const DatabaseSnapshot &snapshot);
+
+	// Index of the class in the table, -1 if the class has no spell slots
+	int classIndex(const QString &className) const { return this->classIndices.value(className, -1); }
+	bool isPactCaster(const QString &className) const { return className == "Warlock"; }
+
+	int count(int classIndex, int characterLevel, int spellLevel) const;
+	Slots slotsFor(const QString &className, int characterLevel) const;
+
+	// Warlock slots come from Pact Magic and are tracked apart from the shared slots
+	Slots pactSlots(int warlockLevel) const { return this->slotsFor("Warlock", warlockLevel); }
+
+	// Shared slots for a character with levels in several classes, ex. {{"Wizard", 3}, {"Paladin", 4}}.
+	// Full casters add their whole level to the caster level, Paladins and Rangers add half,
+	// and a single spellcasting class keeps its own table.
+	Slots multiclassSlots(const QMap<QString, int> &classLevels) const;
+	int casterLevel(const QMap<QString, int> &classLevels) const;
+
+private:
+	// Flat [class][level - 1][spell level - 1] array so every lookup is a single index
+	static int offset(int classIndex, int characterLevel, int spellLevel)
+	{
+		return (classIndex * maxCharacterLevel + characterLevel - 1) * maxSpellLevel + spellLevel - 1;
+	}
+
+	QHash<QString, int> classIndices;
+	QVector<quint8> table;
+	QVector<quint8> casterLevelTable; // full caster slots by caster level, used for multiclassing
+};
+
+#endif // SPELLSLOTTABLE_H
@@ -0,0 +1,127 @@
+/*
+Name: spellSortFilterProxy.cpp
+Description: Keeps a SpellTableModel ordered by level, then name, then any columns the user picks, and hides
+			 spells outside the chosen school or without concentration, ritual or prepared. Sorting stays
+			 live, so an added spell is placed by binary search instead of sorting the whole list again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellSortFilterProxy.h"
+#include "spellTableModel.h"
+
+SpellSortFilterProxy::SpellSortFilterProxy(QObject *parent)
+	: QSortFilterProxyModel(parent)
+{
+	// Numeric mode puts page 9 before page 10
+	this->collator.setNumericMode(true);
+	this->collator.setCaseSensitivity(Qt::CaseInsensitive);
+
+	// With a sort column set and dynamic sorting on, rows added or changed in the spell model are moved
+	// into place one at a time. The column only switches sorting on, lessThan compares every key
+	this->setDynamicSortFilter(true);
+	this->sort(0, Qt::AscendingOrder);
+}
+
+void SpellSortFilterProxy::setUserKeys(const QVector<SortKey> &keys)
+{
+	this->userKeys = keys;
+	this->invalidate();
+}
+
+QVector<SpellSortFilterProxy::SortKey> SpellSortFilterProxy::sortKeys() const
+{
+	QVector<SortKey> keys = {{SpellTableModel::Level, Qt::AscendingOrder}, {SpellTableModel::Name, Qt::AscendingOrder}};
+	keys += this->userKeys;
+	return keys;
+}
+
+void SpellSortFilterProxy::setSchool(const QString &school)
+{
+	this->school = school;
+	this->invalidateFilter();
+}
+
+void SpellSortFilterProxy::setRequireConcentration(bool required)
+{
+	this->requireConcentration = required;
+	this->invalidateFilter();
+}
+
+void SpellSortFilterProxy::setRequireRitual(bool required)
+{
+	this->requireRitual = required;
+	this->invalidateFilter();
+}
+
+void SpellSortFilterProxy::setRequirePrepared(bool required)
+{
+	this->requirePrepared = required;
+	this->invalidateFilter();
+}
+
+bool SpellSortFilterProxy::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+	const SpellRecord *a = this->spellAt(left.row());
+	const SpellRecord *b = this->spellAt(right.row());
+	if (!a || !b)
+	{
+		return QSortFilterProxyModel::lessThan(left, right);
+	}
+
+	for (const SortKey &key : this->sortKeys())
+	{
+		int order = this->compare(*a, *b, key.column);
+		if (order != 0)
+		{
+			return key.order == Qt::AscendingOrder ? order < 0 : order > 0;
+		}
+	}
+
+	// Equal on every key, keeping the spell model's order makes the sort stable
+	return left.row() < right.row();
+}
+
+bool SpellSortFilterProxy::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+	Q_UNUSED(sourceParent);
+	const SpellRecord *spell = this->spellAt(sourceRow);
+	if (!spell)
+	{
+		return true;
+	}
+
+	if (!this->school.isEmpty() && spell->school.compare(this->school, Qt::CaseInsensitive) != 0)
+	{
+		return false;
+	}
+	return (!this->requireConcentration || spell->concentration) && (!this->requireRitual || spell->ritual) &&
+		   (!this->requirePrepared || spell->prepared);
+}
+
+const SpellRecord *SpellSortFilterProxy::spellAt(int sourceRow) const
+{
+	// Compared straight from the records, going through data() would build a QVariant per key
+	const SpellTableModel *spells = qobject_cast<const SpellTableModel *>(this->sourceModel());
+	if (!spells || sourceRow < 0 || sourceRow >= spells->rowCount())
+	{
+		return nullptr;
+	}
+	return &spells->spell(sourceRow);
+}
+
+int SpellSortFilterProxy::compare(const SpellRecord &a, const SpellRecord &b, int column) const
+{
+	if (column == SpellTableModel::Level)
+	{
+		return a.level - b.level;
+	}
+	if (SpellTableModel::isCheckColumn(column))
+	{
+		return int(SpellTableModel::flag(a, column)) - int(SpellTableModel::flag(b, column));
+	}
+	return this->collator.compare(SpellTableModel::value(a, column).toString(),
+								  SpellTableModel::value(b, column).toString());
+}
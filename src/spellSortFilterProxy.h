@@ -0,0 +1,59 @@
+/*
+Name: spellSortFilterProxy.h
+Description: Keeps a SpellTableModel ordered by level, then name, then any columns the user picks, and hides
+			 spells outside the chosen school or without concentration, ritual or prepared. Sorting stays
+			 live, so an added spell is placed by binary search instead of sorting the whole list again.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLSORTFILTERPROXY_H
+#define SPELLSORTFILTERPROXY_H
+
+#include <QCollator>
+#include <QSortFilterProxyModel>
+#include <QVector>
+
+struct SpellRecord;
+
+class SpellSortFilterProxy : public QSortFilterProxyModel
+{
+	Q_OBJECT
+public:
+	struct SortKey
+	{
+		int column;
+		Qt::SortOrder order;
+	};
+
+	explicit SpellSortFilterProxy(QObject *parent = nullptr);
+
+	// Level then name always come first, the user's keys break ties between them
+	void setUserKeys(const QVector<SortKey> &keys);
+	QVector<SortKey> sortKeys() const;
+
+	// An empty school shows every school, the flags hide spells without them when set
+	void setSchool(const QString &school);
+	void setRequireConcentration(bool required);
+	void setRequireRitual(bool required);
+	void setRequirePrepared(bool required);
+
+protected:
+	bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+	bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+	const SpellRecord *spellAt(int sourceRow) const;
+	int compare(const SpellRecord &a, const SpellRecord &b, int column) const;
+
+	QVector<SortKey> userKeys;
+	QString school;
+	bool requireConcentration = false;
+	bool requireRitual = false;
+	bool requirePrepared = false;
+	QCollator collator;
+};
+
+#endif // SPELLSORTFILTERPROXY_H
@@ -0,0 +1,218 @@
+/*
+Name: spellTableModel.cpp
+Description: Table model over a character's spells, one row per SpellRecord. The yes/no columns are check
+			 states painted by CheckBoxDelegate, so a row costs no widgets however many spells there are.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "spellTableModel.h"
+#include "referenceDatabase.h"
+
+#include <QHash>
+
+static const QStringList columnNames = {"Name", "Book", "Page", "Level", "School", "Casting Time", "Range", "Verbal",
+										"Somatic", "Material", "Duration", "Concentration", "Ritual", "Prepared",
+										"Description"};
+
+SpellTableModel::SpellTableModel(QObject *parent)
+	: QAbstractTableModel(parent)
+{
+}
+
+void SpellTableModel::setSpells(const QVector<SpellRecord> &spells)
+{
+	this->beginResetModel();
+	this->rows = spells;
+	this->endResetModel();
+}
+
+void SpellTableModel::addSpell(const SpellRecord &spell)
+{
+	int row = this->rows.size();
+	this->beginInsertRows(QModelIndex(), row, row);
+	this->rows.append(spell);
+	this->endInsertRows();
+}
+
+void SpellTableModel::setLines(const QStringList &lines)
+{
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+	QVector<SpellRecord> spells;
+	spells.reserve(lines.size());
+	QHash<QString, int> rowOf; // lowercase name to row, so a spell entered twice becomes one row
+	for (const QString &line : lines)
+	{
+		bool ok = false;
+		SpellRecord spell = compendium.read(line, &ok);
+		if (!ok)
+		{
+			continue;
+		}
+
+		QString key = spell.name.trimmed().toLower();
+		auto it = rowOf.constFind(key);
+		if (it != rowOf.constEnd())
+		{
+			spells[it.value()].prepared = spells[it.value()].prepared || spell.prepared;
+			continue;
+		}
+		rowOf.insert(key, spells.size());
+		spells.append(spell);
+	}
+	this->setSpells(spells);
+}
+
+QByteArray SpellTableModel::toCsv() const
+{
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+	QString contents;
+	for (const SpellRecord &spell : this->rows)
+	{
+		contents += compendium.write(spell) + "\n";
+	}
+	return contents.toUtf8();
+}
+
+bool SpellTableModel::isCheckColumn(int column)
+{
+	return column == Verbal || column == Somatic || column == Material || column == Concentration ||
+		   column == Ritual || column == Prepared;
+}
+
+int SpellTableModel::rowCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : this->rows.size();
+}
+
+int SpellTableModel::columnCount(const QModelIndex &parent) const
+{
+	return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant SpellTableModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= this->rows.size())
+	{
+		return QVariant();
+	}
+
+	const SpellRecord &spell = this->rows[index.row()];
+	int column = index.column();
+	if (isCheckColumn(column))
+	{
+		if (role == Qt::CheckStateRole)
+		{
+			return int(flag(spell, column) ? Qt::Checked : Qt::Unchecked);
+		}
+		return QVariant();
+	}
+
+	switch (role)
+	{
+	case Qt::DisplayRole:
+	case Qt::EditRole:
+		return value(spell, column);
+	case Qt::TextAlignmentRole:
+		return int(Qt::AlignCenter);
+	}
+	return QVariant();
+}
+
+bool SpellTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+	if (!index.isValid() || index.row() >= this->rows.size())
+	{
+		return false;
+	}
+
+	SpellRecord &spell = this->rows[index.row()];
+	if (role == Qt::CheckStateRole && index.column() == Prepared)
+	{
+		spell.prepared = value.toInt() == Qt::Checked;
+	}
+	else if (role == Qt::EditRole && !isCheckColumn(index.column()))
+	{
+		QString text = value.toString();
+		switch (index.column())
+		{
+		case Name: spell.name = text; break;
+		case Book: spell.book = text; break;
+		case Page: spell.page = text; break;
+		case Level: spell.level = text.toInt(); break;
+		case School: spell.school = text; break;
+		case CastingTime: spell.castingTime = text; break;
+		case Range: spell.range = text; break;
+		case Duration: spell.duration = text; break;
+		case Description: spell.description = text; break;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	emit dataChanged(index, index, {role});
+	return true;
+}
+
+QVariant SpellTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < columnNames.size())
+	{
+		return columnNames[section];
+	}
+	return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags SpellTableModel::flags(const QModelIndex &index) const
+{
+	if (!index.isValid())
+	{
+		return Qt::NoItemFlags;
+	}
+
+	// Components, concentration and ritual belong to the spell, only whether it is prepared is picked
+	if (index.column() == Prepared)
+	{
+		return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsUserCheckable;
+	}
+	if (isCheckColumn(index.column()))
+	{
+		return Qt::ItemIsSelectable;
+	}
+	return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+}
+
+bool SpellTableModel::flag(const SpellRecord &spell, int column)
+{
+	switch (column)
+	{
+	case Verbal: return spell.verbal;
+	case Somatic: return spell.somatic;
+	case Material: return spell.material;
+	case Concentration: return spell.concentration;
+	case Ritual: return spell.ritual;
+	case Prepared: return spell.prepared;
+	}
+	return false;
+}
+
+QVariant SpellTableModel::value(const SpellRecord &spell, int column)
+{
+	switch (column)
+	{
+	case Name: return spell.name;
+	case Book: return spell.book;
+	case Page: return spell.page;
+	case Level: return spell.level;
+	case School: return spell.school;
+	case CastingTime: return spell.castingTime;
+	case Range: return spell.range;
+	case Duration: return spell.duration;
+	case Description: return spell.description;
+	}
+	return QVariant();
+}
@@ -0,0 +1,74 @@
+/*
+Name: spellTableModel.h
+Description: Table model over a character's spells, one row per SpellRecord. The yes/no columns are check
+			 states painted by CheckBoxDelegate, so a row costs no widgets however many spells there are.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef SPELLTABLEMODEL_H
+#define SPELLTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+
+#include "spellRecord.h"
+
+class SpellTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+public:
+	enum Column
+	{
+		Name,
+		Book,
+		Page,
+		Level,
+		School,
+		CastingTime,
+		Range,
+		Verbal,
+		Somatic,
+		Material,
+		Duration,
+		Concentration,
+		Ritual,
+		Prepared,
+		Description,
+		ColumnCount
+	};
+
+	explicit SpellTableModel(QObject *parent = nullptr);
+
+	void setSpells(const QVector<SpellRecord> &spells);
+	void addSpell(const SpellRecord &spell);
+	const QVector<SpellRecord> &spells() const { return this->rows; }
+	const SpellRecord &spell(int row) const { return this->rows[row]; }
+
+	// Reads and writes the lines of spells.csv through the spell compendium, lines that are not spells
+	// are skipped and a spell listed twice is kept once
+	void setLines(const QStringList &lines);
+	QByteArray toCsv() const;
+
+	static bool isCheckColumn(int column);
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+	bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+	// A spell's yes/no column or its text and level columns, without building a model index
+	static bool flag(const SpellRecord &spell, int column);
+	static QVariant value(const SpellRecord &spell, int column);
+
+private:
+	QVector<SpellRecord> rows;
+};
+
+#endif // SPELLTABLEMODEL_H
@@ -4,19 +4,18 @@ body: Implementation of the SpellsWidget class, which allows users to select spe
 Authors: Josh Park
 Other Sources: ...
 Date Created: 11/27/2024
-Last Modified: 12/1/2024
+Last Modified: 10/17/2026
 */
 
 #include "addCharacter.h"
+#include "spellDialog.h"
 
 #include <QFile>
 #include <QDialog>
-#include <QCheckBox>
-#include <QTextEdit>
 
 SpellsWidget::SpellsWidget(QWidget * parent) 
 : QWidget(parent) {
-	this->spells = new QMap<QString, SpellInfo *>;
+	this->spells = new QMap<QString, SpellRecord>;
 
 	// Create the main layout
 	QGridLayout * mainLayout = new QGridLayout(this);
@@ -99,170 +98,26 @@ void SpellsWidget::nextPage()
 }
 
 void SpellsWidget::addSpell() {
-	QDialog popup;
-
-	popup.setWindowModality(Qt::ApplicationModal); // stios the user from interacting with the main window while the popup is open
-	popup.setWindowTitle("Add Spell");			   // set the title of the popup
-
-	QLabel *popupHeader = new QLabel("Add Spell"); // creates the header text for the popup
-
-	QLabel * bookLabel = new QLabel("Book Abbreviation:");
-	QLineEdit * book = new QLineEdit();
-
-	QLabel * pageLabel = new QLabel("Page:");
-	QSpinBox * page = new QSpinBox();
-	page->setMaximum(999);
-
-	// spell attributes and labels
-	QLabel *nameLabel = new QLabel("Name"); // label for textbox
-	QLineEdit *spellName = new QLineEdit();
-
-	QLabel * levelLabel = new QLabel("Level");
-	QSpinBox * level = new QSpinBox();
-	level->setRange(0, 9);
-
-	QLabel * schoolLabel = new QLabel("School of Magic");
-	QLineEdit * school = new QLineEdit();
-
-	QLabel * timeLabel = new QLabel("Casting Time");
-	QLineEdit * time = new QLineEdit();
-
-	QLabel * rangeLabel = new QLabel("Range");
-	QLabel * minRangeLabel = new QLabel("Min");
-	QLabel * maxRangeLabel = new QLabel("Max");
-	QSpinBox * minRange = new QSpinBox();	
-	QSpinBox * maxRange = new QSpinBox();
-	maxRange->setMaximum(360);
-
-	QLabel * componentsLabel = new QLabel("Components");
-	QLabel * verbalLabel = new QLabel("Verbal");
-	QLabel * somaticLabel = new QLabel("Somatic");
-	QLabel * materialLabel = new QLabel("Material");
-	QCheckBox * verbal = new QCheckBox();
-	QCheckBox * somatic = new QCheckBox();
-	QCheckBox * material = new QCheckBox();
-
-	QLabel * durationLabel = new QLabel("Duration");
-	QLineEdit * duration = new QLineEdit();
-
-	QLabel * concentrationLabel = new QLabel("Concentration");
-	QCheckBox * concentration = new QCheckBox();
-	
-	QLabel * ritualLabel = new QLabel("Ritual");
-	QCheckBox * ritual = new QCheckBox();
-
-	QLabel * descriptionLabel = new QLabel("Description");
-	QTextEdit * description = new QTextEdit();
-
-	// create the buttons for the popup
-	QPushButton *popupConfirm = new QPushButton("Confirm"); // creates the confirm button
-	QPushButton *popupCancel = new QPushButton("Cancel");	// creates the cancel button
-
-	// Gets rid of the padding around the text of the buttons
-	popupConfirm->setStyleSheet("padding: 5px 0px; margin: 0px;");
-	popupCancel->setStyleSheet("padding: 5px 0px; margin: 0px;");
-
-	// Connect the confirm button to accept the dialog (e.g., confirming the deletion)
-	QObject::connect(popupConfirm, &QPushButton::clicked, &popup, &QDialog::accept);
-
-	// Connect the cancel button to reject the dialog (e.g., canceling the deletion)
-	QObject::connect(popupCancel, &QPushButton::clicked, &popup, &QDialog::reject);
-
-	// create the layout for the popup
-	QVBoxLayout * popupLayout = new QVBoxLayout(&popup);
-
-	// create the layout for the header of the popup
-	QHBoxLayout * popupHeaderLayout = new QHBoxLayout();
-
-	// creates the layout for the body of the popup
-	QGridLayout * popupBodyLayout = new QGridLayout();
-
-	// Create button widget
-	QHBoxLayout * popupButtonLayout = new QHBoxLayout();
-
-	// adds the header components to the header layout
-	popupHeaderLayout->addWidget(popupHeader);
-	popupBodyLayout->addWidget(bookLabel, 0, 0, 1, 1, {Qt::AlignLeft});
-	popupBodyLayout->addWidget(book, 0, 1, 1, 1, {Qt::AlignLeft});
-	popupBodyLayout->addWidget(pageLabel, 0, 2, 1, 1, {Qt::AlignLeft});
-	popupBodyLayout->addWidget(page, 0, 3, 1, 1, {Qt::AlignLeft});
-
-	// adds the attributes to the body layout
-	popupBodyLayout->addWidget(nameLabel, 1, 0, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(spellName, 2, 0, 2, 1);
-
-	popupBodyLayout->addWidget(levelLabel, 1, 1, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(level, 2, 1, 2, 1);
-
-	popupBodyLayout->addWidget(schoolLabel, 1, 2, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(school, 2, 2, 2, 1);
-
-	popupBodyLayout->addWidget(timeLabel, 1, 3, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(time, 2, 3, 2, 1);
-
-	popupBodyLayout->addWidget(rangeLabel, 1, 4, 1, 2, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(minRangeLabel, 2, 4, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(minRange, 3, 4, 1, 1);
-	popupBodyLayout->addWidget(maxRangeLabel, 2, 5, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(maxRange, 3, 5, 1, 1);
-
-	popupBodyLayout->addWidget(componentsLabel, 1, 6, 1, 3, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(verbalLabel, 2, 6, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(verbal, 3, 6, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(somaticLabel, 2, 7, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(somatic, 3, 7, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(materialLabel, 2, 8, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(material, 3, 8, 1, 1, {Qt::AlignCenter});
-
-	popupBodyLayout->addWidget(durationLabel, 1, 9, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(duration, 2, 9, 2, 1);
-
-	popupBodyLayout->addWidget(concentrationLabel, 1, 10, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(concentration, 2, 10, 2, 1, {Qt::AlignCenter});
-	
-	popupBodyLayout->addWidget(ritualLabel, 1, 11, 1, 1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(ritual, 2, 11, 2, 1, {Qt::AlignCenter});
-
-	popupBodyLayout->addWidget(descriptionLabel, 4, 0, 1, -1, {Qt::AlignCenter});
-	popupBodyLayout->addWidget(description, 5, 0, -1, -1);
-
-	// adds the buttons to the button layout
-	popupButtonLayout->addWidget(popupConfirm);
-	popupButtonLayout->addWidget(popupCancel);
-
-	// adds the components to the popup
-	popupLayout->addLayout(popupHeaderLayout);
-	popupLayout->addLayout(popupBodyLayout);
-	popupLayout->addLayout(popupButtonLayout);
-
-	// makes the popup text take up more horizontal space
-	popupLayout->setStretch(0, 1);
+	QString className;
+	AddCharacter * stackedWidget = qobject_cast<AddCharacter *>(this->parentWidget());
+	ClassWidget * classWidget = stackedWidget ? qobject_cast<ClassWidget *>(stackedWidget->widget(2)) : nullptr;
+	if (classWidget) {
+		className = classWidget->getClass();
+	}
 
-	// show the popup
-	popup.exec();
+	// One dialog picks all the remaining spells, spells already chosen are left out of it
+	QStringList known;
+	for (int row = 0; row < this->spellsList->count(); row++) {
+		known.append(this->spellsList->item(row)->text());
+	}
+	SpellDialog popup(this->numSpells() - this->spellsList->count(), className, 1, known, this);
 
-	if (popup.result() == QDialog::Accepted)
+	if (popup.exec() == QDialog::Accepted)
 	{
-		this->spellsList->addItem(spellName->text());
-		SpellInfo * info = new SpellInfo;
-		info->book = book->text();
-		info->page = page->value();
-		info->level = level->value();
-		info->school = school->text();
-		info->time = time->text();
-		info->minRange = minRange->value();
-		info->maxRange = maxRange->value();
-		info->verbal = verbal->isChecked();
-		info->somatic = somatic->isChecked();
-		info->material = material->isChecked();
-		info->duration = duration->text();
-		info->concentration = concentration->isChecked();
-		info->ritual = ritual->isChecked();
-		QString desc = description->toPlainText();
-		QRegularExpression re("\n");
-		desc.replace(re,"<br>");
-		info->description = desc;
-		(*this->spells)[spellName->text()] = info;
+		for (const SpellRecord &spell : popup.chosenSpells()) {
+			this->spellsList->addItem(spell.name);
+			(*this->spells)[spell.name] = spell;
+		}
 	}
 	
 	// this is so that no spell is selected after creation
@@ -409,28 +264,16 @@ void SpellsWidget::updateNumSpells() {
 	header->setText(headerstr.c_str());
 }
 
-void SpellsWidget::recordSpells(QString charPath) {
-	QFile spellsFile(charPath + "/spells.csv");
-
-	if (spellsFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-		while (auto spell = this->spellsList->takeItem(0)) {
-			QString spellName = spell->text();
-			SpellInfo * info = (*this->spells)[spellName];
-
-			QTextStream out(&spellsFile);
-
-			out << spellName << "," << info->book << "," << info->page << "," << info->level << "," << info->school << "," << info->time << "," << info->maxRange << ",";
-			if (info->verbal) {
-				out << "v";
-			}
-			if (info->somatic) {
-				out << "s";
-			}
-			if (info->material) {
-				out << "m";
-			}
-			out << "," << info->duration << "," << info->concentration << "," << info->ritual << ",0," << info->description << Qt::endl;
-		}
-		spellsFile.close();
+QByteArray SpellsWidget::recordSpells() {
+	QString contents;
+	QTextStream out(&contents);
+
+	// Spells from the compendium are written as just their name
+	const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+	while (auto spell = this->spellsList->takeItem(0)) {
+		out << compendium.write((*this->spells)[spell->text()]) << Qt::endl;
+		delete spell;
 	}
+	out.flush();
+	return contents.toUtf8();
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+Name: statGraph.cpp
+Description: Dependency graph of a character's derived stats (ability score to modifier to saves, skills,
+			 initiative, armor class and spell save DC). Changing an input recomputes only the stats
+			 downstream of it and only calls the listeners of stats whose value actually changed.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "statGraph.h"
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+int StatGraph::addInput(int value)
+{
+	Node node;
+	node.value = value;
+	this->nodes.append(node);
+	return this->nodes.size() - 1;
+}
+
+int StatGraph::addDerived(const QVector<int> &inputs, Compute compute)
+{
+	int id = this->nodes.size();
+	for (int input : inputs)
+	{
+		this->nodes[input].dependents.append(id);
+	}
+
+	Node node;
+	node.compute = compute;
+	node.value = compute();
+	this->nodes.append(node);
+	return id;
+}
+
+void StatGraph::set(int node, int value)
+{
+	if (this->nodes[node].value == value)
+	{
+		return;
+	}
+	this->nodes[node].value = value;
+	this->propagate(node);
+}
+
+void StatGraph::invalidate(int node)
+{
+	int value = this->nodes[node].compute();
+	if (this->nodes[node].value == value)
+	{
+		return;
+	}
+	this->nodes[node].value = value;
+	this->propagate(node);
+}
+
+void StatGraph::bind(int node, Listener listener)
+{
+	listener(this->nodes[node].value);
+	this->nodes[node].listeners.append(listener);
+}
+
+void StatGraph::propagate(int source)
+{
+	// Ids are in dependency order, so visiting the lowest pending id first recomputes a node only after
+	// every changed node it reads, and each node at most once
+	std::priority_queue<int, std::vector<int>, std::greater<int>> pending;
+	QVector<bool> queued(this->nodes.size(), false);
+	auto enqueueDependents = [this, &pending, &queued](int node) {
+		for (int dependent : this->nodes[node].dependents)
+		{
+			if (!queued[dependent])
+			{
+				queued[dependent] = true;
+				pending.push(dependent);
+			}
+		}
+	};
+
+	this->notify(source);
+	enqueueDependents(source);
+	while (!pending.empty())
+	{
+		int node = pending.top();
+		pending.pop();
+
+		int value = this->nodes[node].compute();
+		if (value == this->nodes[node].value)
+		{
+			continue; // nothing past this node can change through it
+		}
+		this->nodes[node].value = value;
+		this->notify(node);
+		enqueueDependents(node);
+	}
+}
+
+void StatGraph::notify(int node) const
+{
+	for (const Listener &listener : this->nodes[node].listeners)
+	{
+		listener(this->nodes[node].value);
+	}
+}
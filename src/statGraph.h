@@ -0,0 +1,52 @@
+/*
+Name: statGraph.h
+Description: Dependency graph of a character's derived stats (ability score to modifier to saves, skills,
+			 initiative, armor class and spell save DC). Changing an input recomputes only the stats
+			 downstream of it and only calls the listeners of stats whose value actually changed.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef STATGRAPH_H
+#define STATGRAPH_H
+
+#include <QVector>
+#include <functional>
+
+class StatGraph
+{
+public:
+	using Compute = std::function<int()>;
+	using Listener = std::function<void(int value)>;
+
+	// A node has to be added after every node it reads, so node ids are already in dependency order
+	int addInput(int value = 0);
+	int addDerived(const QVector<int> &inputs, Compute compute);
+
+	int value(int node) const { return this->nodes[node].value; }
+	// Changes an input and recomputes the nodes downstream of it, nothing happens if the value is the same
+	void set(int node, int value);
+	// Recomputes a derived node that also reads state outside the graph, ex. the equipped armor
+	void invalidate(int node);
+	// Calls the listener with the node's value now and again every time it changes
+	void bind(int node, Listener listener);
+
+private:
+	struct Node
+	{
+		int value = 0;
+		Compute compute; // empty for inputs
+		QVector<int> dependents;
+		QVector<Listener> listeners;
+	};
+
+	// Tells the listeners of a node that just changed and recomputes everything downstream of it
+	void propagate(int source);
+	void notify(int node) const;
+
+	QVector<Node> nodes;
+};
+
+#endif // STATGRAPH_H
@@ -0,0 +1,140 @@
+/*
+Name: thumbnailCache.cpp
+Description: Two level cache of pre-scaled images. QPixmapCache holds the ones in use this session
+			 and data/cache/thumbnails keeps them on disk between runs, dropping the least recently used
+			 once it grows past its limit so thumbnails of deleted characters and replaced portraits go.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#include "thumbnailCache.h"
+#include "portraitLoader.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QAtomicInt>
+#include <QFile>
+#include <QFileInfo>
+#include <QPixmapCache>
+#include <QSaveFile>
+
+// The wizard artwork alone is a few dozen 450x600 images, more than the default QPixmapCache limit
+static const int minimumPixmapCacheKB = 48 * 1024;
+
+// Thumbnails on disk past this size are removed, least recently used first
+static const qint64 maximumDiskCacheBytes = 64 * 1024 * 1024;
+
+static QAtomicInt pruned(0);
+
+QString ThumbnailCache::cacheDirectory()
+{
+	return QDir::currentPath() + "/data/cache/thumbnails";
+}
+
+QString ThumbnailCache::key(const QString &sourcePath, const QSize &size, bool crop)
+{
+	QFileInfo source(sourcePath);
+	if (!source.exists())
+	{
+		return QString();
+	}
+
+	return source.absoluteFilePath() + "|" + QString::number(source.lastModified().toMSecsSinceEpoch()) + "|" +
+		   QString::number(size.width()) + "x" + QString::number(size.height()) + (crop ? "|crop" : "");
+}
+
+QImage ThumbnailCache::image(const QString &sourcePath, const QSize &size, bool crop)
+{
+	QString cacheKey = key(sourcePath, size, crop);
+	if (cacheKey.isEmpty())
+	{
+		return QImage();
+	}
+
+	// Hash the key so it is a safe file name
+	QString fileName = QString::fromLatin1(QCryptographicHash::hash(cacheKey.toUtf8(), QCryptographicHash::Sha1).toHex()) + ".png";
+	QString cachedPath = cacheDirectory() + "/" + fileName;
+
+	QImage thumbnail(cachedPath);
+	if (!thumbnail.isNull())
+	{
+		// The modified time records when it was last used, so pruning keeps the ones still shown
+		QFile cached(cachedPath);
+		if (cached.open(QIODevice::ReadWrite))
+		{
+			cached.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+		}
+		return thumbnail;
+	}
+
+	// Not cached yet, decode the source once and keep the result for next time
+	thumbnail = PortraitLoader::decode(sourcePath, size, crop);
+	if (thumbnail.isNull())
+	{
+		return thumbnail;
+	}
+
+	QDir().mkpath(cacheDirectory());
+	QSaveFile cacheFile(cachedPath);
+	if (!cacheFile.open(QIODevice::WriteOnly) || !thumbnail.save(&cacheFile, "PNG") || !cacheFile.commit())
+	{
+		qDebug() << "Failed to write thumbnail:" << cachedPath;
+	}
+
+	// Images are called for from several threads at once, only the first new thumbnail of a run prunes
+	if (pruned.testAndSetOrdered(0, 1))
+	{
+		prune();
+	}
+	return thumbnail;
+}
+
+void ThumbnailCache::prune()
+{
+	// Newest first, everything after the limit is reached goes
+	const QFileInfoList files = QDir(cacheDirectory()).entryInfoList({"*.png"}, QDir::Files, QDir::Time);
+	qint64 total = 0;
+	int removed = 0;
+	for (const QFileInfo &file : files)
+	{
+		total += file.size();
+		if (total > maximumDiskCacheBytes && QFile::remove(file.absoluteFilePath()))
+		{
+			removed++;
+		}
+	}
+	if (removed > 0)
+	{
+		qDebug() << "Removed" << removed << "unused thumbnails";
+	}
+}
+
+QPixmap ThumbnailCache::pixmap(const QString &sourcePath, const QSize &size, bool crop)
+{
+	QString cacheKey = key(sourcePath, size, crop);
+	if (cacheKey.isEmpty())
+	{
+		return QPixmap();
+	}
+
+	QPixmap thumbnail;
+	if (QPixmapCache::find(cacheKey, &thumbnail))
+	{
+		return thumbnail;
+	}
+
+	thumbnail = QPixmap::fromImage(image(sourcePath, size, crop));
+	if (!thumbnail.isNull())
+	{
+		if (QPixmapCache::cacheLimit() < minimumPixmapCacheKB)
+		{
+			QPixmapCache::setCacheLimit(minimumPixmapCacheKB);
+		}
+		QPixmapCache::insert(cacheKey, thumbnail);
+	}
+	return thumbnail;
+}
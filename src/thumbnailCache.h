@@ -0,0 +1,38 @@
+/*
+Name: thumbnailCache.h
+Description: Two level cache of pre-scaled images. QPixmapCache holds the ones in use this session
+			 and data/cache/thumbnails keeps them on disk between runs, dropping the least recently used
+			 once it grows past its limit so thumbnails of deleted characters and replaced portraits go.
+Authors: Josh Park
+Other Sources: ...
+Date Created: 10/17/2026
+Last Modified: 10/17/2026
+*/
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+class ThumbnailCache
+{
+public:
+	// Returns the image at sourcePath scaled to fit size (center cropped to its aspect ratio if crop is true),
+	// or a null pixmap if the image can not be read. Must be called from the GUI thread.
+	static QPixmap pixmap(const QString &sourcePath, const QSize &size, bool crop = false);
+
+	// Same as pixmap() without the in-memory layer, safe to call from any thread
+	static QImage image(const QString &sourcePath, const QSize &size, bool crop = false);
+
+private:
+	// Entries are keyed by source path, modification time, and target size so edits to an image are picked up
+	static QString key(const QString &sourcePath, const QSize &size, bool crop);
+	static QString cacheDirectory();
+	// Removes the least recently used thumbnails on disk until they fit the limit, once per run
+	static void prune();
+};
+
+#endif // THUMBNAILCACHE_H
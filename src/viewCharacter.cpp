@@ -4,7 +4,7 @@ Description: Page to view a character's information, notes, and stats.
 Authors: Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 10/25/2024
-Last Modified: 11/18/2024
+Last Modified: 10/17/2026
 */
 
 #include <QComboBox>
@@ -37,13 +37,19 @@ Last Modified: 11/18/2024
 #include <QPropertyAnimation>
 #include <QParallelAnimationGroup>
 #include <QGraphicsOpacityEffect>
+#include <QTimer>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
 #include "viewCharacter.h"
+#include "characterIndex.h"
+#include "characterStorage.h"
 #include "viewInventory.h"
+#include "viewSpells.h"
 #include "viewNotes.h"
+#include "spellDialog.h"
+#include "fuzzyCompleter.h"
 #include "themeUtils.h" // Include the utility header
 #include "utils.h"
 
@@ -82,6 +88,12 @@ public:
     }
 };
 
+// Formats a bonus with its sign, ex. +2 or -1
+static QString signedNumber(int value)
+{
+    return (value >= 0 ? "+" : "") + QString::number(value);
+}
+
 QMap<QString, int> skillMap =
     {
         // The key is the skill's name, and the value is the index corresponding to the ability that the skill is based on
@@ -108,39 +120,37 @@ QMap<QString, int> skillMap =
 void ViewCharacter::loadAll()
 {
     loadCharacter(name);                                                              // Load the character's information
-    evaluateCharacterModifiers();                                                     // Evaluate the character's modifiers
-    loadPicture(QDir::currentPath() + "/data/characters/" + name + "/character.png"); // Load the character's picture
+    evaluateCharacterModifiers();                                                     // Update the stat inputs, only the labels of stats that changed are redrawn
+    loadPicture(picturePath());                                                       // Load the character's picture
     loadEquippedItems();                                                              // Load the character's equipped items
     loadPreppedSpells();                                                              // Load the character's prepped spells
 }
 
 void ViewCharacter::loadCharacter(QString name)
 {
-    // Load the character's information, notes, and stats
-    QString path = QDir::currentPath() + "/data/characters/" + name;
+    // Save anything still waiting to be written before reading the file again
+    commitCharacterFile();
 
     // Load the character's information
-    QFile characterFile(path + "/character.csv");
+    characterFile = CharacterFile(name);
 
-    if (characterFile.open(QIODevice::ReadOnly))
+    if (characterFile.load())
     {
-        /*
-            Character File Format:
-            1|    Name,Str,Dex,Con,Int,Wis,Cha,Level:Experience,MaxHealth:CurrentHealth:TempHealth,Class,Sub,Race
-            2|    Stat Proficiencies (comma separated)(entire line)
-            3|    Feats (comma separated)(entire line)
-            4|    Languages (comma separated)(entire line)
-            5|    Equipment Proficiencies (comma separated)(entire line)
-            6|    Coins (platinum,gold,silver,copper)
-        */
-
-        QTextStream in(&characterFile);
-        // Can not loop through each line because lines are not consistent in context
-        // Get the first line of character information
-        QString line = in.readLine();
+        // Reloading replaces the lists instead of adding to them
+        characterAbilities.clear();
+        characterSkillProficiencies.clear();
+        characterFeats.clear();
+        characterLanguages.clear();
+        characterEquipmentProficiencies.clear();
+        characterCoins.clear();
 
         // Get first line of character information
-        QStringList line1 = line.split(",");
+        QStringList line1 = characterFile.record(CharacterFile::Stats).split(",");
+        if (line1.size() < 13)
+        {
+            qWarning() << "Invalid character file for" << name;
+            return;
+        }
 
         characterName = line1[0];
         for (int i = 1; i < 7; i++)
@@ -149,7 +159,7 @@ void ViewCharacter::loadCharacter(QString name)
         }
         QStringList levelExperienceList = line1[7].split(":");
         characterLevel = levelExperienceList[0].toInt();
-        characterExperience = levelExperienceList[1].toInt();
+        characterExperience = levelExperienceList.value(1).toInt();
 
         //  if character experience is -1, then the character is using milestone leveling
         qDebug() << "Character Experience: " << characterExperience;
@@ -161,61 +171,27 @@ void ViewCharacter::loadCharacter(QString name)
 
         QStringList hitPointsList = line1[8].split(":");
         characterMaxHitPoints = hitPointsList[0].toInt();
-        characterHitPoints = hitPointsList[1].toInt();
-        characterTempHitPoints = hitPointsList[2].toInt();
+        characterHitPoints = hitPointsList.value(1).toInt();
+        characterTempHitPoints = hitPointsList.value(2).toInt();
         characterClass = line1[9];
         characterSubclass = line1[10];
         characterRace = line1[11];
         characterSubrace = line1[12];
 
-        // Get the second line of character information
-        line = in.readLine();
-        QStringList line2 = line.split(",");
-        for (int i = 0; i < line2.size(); i++)
-        {
-            if (line2[i] != "" && line2[i] != " ")
-                characterSkillProficiencies.append(line2[i]); // Add stat proficiencies to the list
-        }
-
-        // Get the third line of character information
-        line = in.readLine();
-        QStringList line3 = line.split(",");
-        for (int i = 0; i < line3.size(); i++)
+        // The rest of the records are comma separated lists
+        characterSkillProficiencies = characterFile.list(CharacterFile::SkillProficiencies);
+        characterFeats = characterFile.list(CharacterFile::Feats);
+        characterLanguages = characterFile.list(CharacterFile::Languages);
+        characterEquipmentProficiencies = characterFile.list(CharacterFile::EquipmentProficiencies);
+        for (const QString &coin : characterFile.list(CharacterFile::Coins))
         {
-            if (line3[i] != "" && line3[i] != " ")
-                characterFeats.append(line3[i]); // Add feats to the list
+            characterCoins.append(coin.toInt()); // Add coins to the list
         }
-
-        // Get the fourth line of character information
-        line = in.readLine();
-        QStringList line4 = line.split(",");
-        for (int i = 0; i < line4.size(); i++)
+        while (characterCoins.size() < 4)
         {
-            if (line4[i] != "" && line4[i] != " ")
-                characterLanguages.append(line4[i]); // Add languages to the list
+            characterCoins.append(0);
         }
 
-        // Get the fifth line of character information
-        line = in.readLine();
-        QStringList line5 = line.split(",");
-        for (int i = 0; i < line5.size(); i++)
-        {
-            if (line5[i] != "" && line5[i] != " ")
-                characterEquipmentProficiencies.append(line5[i]); // Add equipment proficiencies to the list
-        }
-
-        // Get the sixth line of character information
-        line = in.readLine();
-        QStringList line6 = line.split(",");
-        for (int i = 0; i < line6.size(); i++)
-        {
-            if (line6[i] != "" && line6[i] != " ")
-                characterCoins.append(line6[i].toInt()); // Add coins to the list
-        }
-
-        // Close the file
-        characterFile.close();
-
         // Print the character to the console for testing
         // printCharacterToConsole();
     }
@@ -242,43 +218,111 @@ void ViewCharacter::printCharacterToConsole()
 
 void ViewCharacter::evaluateCharacterModifiers()
 {
-    // Evaluate the character's modifiers
-    // Modifiers are calculated by taking the stat, subtracting 10, dividing by 2, and rounding down
-    // The proficiency bonus is determined by the character's level
-    characterProficiencyBonus = proficiencyBonusTable[characterLevel - 1];
+    // Only the inputs are set here, the stat graph recomputes the modifiers, saves, skills, initiative,
+    // armor class and spell save DC that depend on a changed input and relabels only those
+    for (int i = 0; i < 6 && i < characterAbilities.size(); i++)
+        stats.set(statNodes.ability[i], characterAbilities[i]);
+
+    stats.set(statNodes.level, characterLevel);
+
+    // Check if the character is proficient in each skill
+    for (int i = 0; i < skillMap.count(); i++)
+        stats.set(statNodes.skillProficient[i], characterSkillProficiencies.contains(skillMap.keys().at(i)) ? 1 : 0);
+}
 
-    // Calculate the character's ability bonuses
+// Builds the derived stats once, evaluateCharacterModifiers only changes their inputs
+void ViewCharacter::buildStatGraph()
+{
     for (int i = 0; i < 6; i++)
-        characterAbilityBonuses.append((int)floor((float)(characterAbilities[i] - 10) / 2));
+    {
+        statNodes.ability[i] = stats.addInput(10);
+    }
+    statNodes.level = stats.addInput(1);
+    for (int i = 0; i < skillMap.count(); i++)
+    {
+        statNodes.skillProficient.append(stats.addInput(0));
+    }
 
-    // Calculate the character's saving throws
+    // Modifiers are calculated by taking the stat, subtracting 10, dividing by 2, and rounding down
     for (int i = 0; i < 6; i++)
-        characterSavingThrows.append(characterAbilityBonuses[i]);
+    {
+        int ability = statNodes.ability[i];
+        statNodes.modifier[i] = stats.addDerived({ability}, [this, ability]()
+                                                 { return (int)floor((float)(stats.value(ability) - 10) / 2); });
+    }
 
-    // Evaluate the character's skill bonuses
-    for (QMap<QString, int>::const_iterator it = skillMap.constBegin(); it != skillMap.constEnd(); it++)
+    // Saving throws use the ability modifier
+    for (int i = 0; i < 6; i++)
     {
-        int abilityIndex = it.value();
+        int modifier = statNodes.modifier[i];
+        statNodes.savingThrow[i] = stats.addDerived({modifier}, [this, modifier]()
+                                                    { return stats.value(modifier); });
+    }
 
-        // Check if the character is proficient in the skill
-        if (characterSkillProficiencies.contains(it.key()))
-            characterSkillBonuses.append(characterAbilityBonuses[abilityIndex] + characterProficiencyBonus);
-        else
-            characterSkillBonuses.append(characterAbilityBonuses[abilityIndex]);
+    // The proficiency bonus is determined by the character's level
+    statNodes.proficiencyBonus = stats.addDerived({statNodes.level}, [this]()
+                                                  { return proficiencyBonusTable[qBound(1, stats.value(statNodes.level), 20) - 1]; });
+
+    // Skills add the proficiency bonus to their ability's modifier if the character is proficient
+    for (int i = 0; i < skillMap.count(); i++)
+    {
+        int modifier = statNodes.modifier[skillMap.values().at(i)];
+        int proficient = statNodes.skillProficient[i];
+        statNodes.skill.append(stats.addDerived({modifier, proficient, statNodes.proficiencyBonus}, [this, modifier, proficient]()
+                                                { return stats.value(modifier) + (stats.value(proficient) ? stats.value(statNodes.proficiencyBonus) : 0); }));
     }
 
-    // Evaluate initiative
-    characterInitiative = characterAbilityBonuses[1];
+    // Initiative uses the dexterity modifier
+    statNodes.initiative = stats.addDerived({statNodes.modifier[1]}, [this]()
+                                            { return stats.value(statNodes.modifier[1]); });
+
+    // Armor class also depends on the equipped armor and shields, equipItem invalidates it when they change
+    QVector<int> armorInputs(statNodes.modifier, statNodes.modifier + 6);
+    armorInputs.append(statNodes.level);
+    statNodes.armorClass = stats.addDerived(armorInputs, [this]()
+                                            {
+        QList<int> modifiers;
+        for (int i = 0; i < 6; i++)
+            modifiers.append(stats.value(statNodes.modifier[i]));
+        armorClass.setAbilityModifiers(modifiers);
+        armorClass.setUnarmoredDefense(ArmorClass::unarmoredDefense(characterClass, characterSubclass, stats.value(statNodes.level)));
+        return armorClass.value(); });
+
+    // Spell save DC is 8 + proficiency bonus + the class's spellcasting ability modifier
+    if (spellcastingAbility.contains(characterClass))
+    {
+        int modifier = statNodes.modifier[spellcastingAbility[characterClass]];
+        statNodes.spellSaveDC = stats.addDerived({modifier, statNodes.proficiencyBonus}, [this, modifier]()
+                                                 { return 8 + stats.value(statNodes.proficiencyBonus) + stats.value(modifier); });
+    }
+}
 
-    // Evaluate armor class
-    if (/*Has armor equipped       leave false until implemented*/ false)
+// Equipping or unequipping one item only adds or removes that item from the armor class
+void ViewCharacter::equipItem(const QString &itemName, bool equipped)
+{
+    if (equipped)
     {
-        // Do armor calculations
+        armorClass.equip(itemName);
     }
     else
-        characterArmorClass = 10 + characterAbilityBonuses[1];
+    {
+        armorClass.unequip(itemName);
+    }
+    stats.invalidate(statNodes.armorClass);
+}
 
-    // Evaluate hit points
+// Called when the whole inventory is replaced
+void ViewCharacter::rebuildArmorClass()
+{
+    armorClass.clearEquipment();
+    for (const InventoryItem &item : inventory->items())
+    {
+        if (item.equipped)
+        {
+            armorClass.equip(item.name);
+        }
+    }
+    stats.invalidate(statNodes.armorClass);
 }
 
 // Allows the user to change the character's profile picture
@@ -311,19 +355,22 @@ void ViewCharacter::changeProfilePicture()
         QFile::copy(fileName, newFileName); // Copy the selected image to the new name
 
         // Load and display the new image
-        QPixmap newPixmap(newFileName);
-        if (!newPixmap.isNull())
-        {
-            pictureLabel->setPixmap(newPixmap.scaled(pictureLabel->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        }
-        else
+        loadPicture(newFileName);
+    }
+}
+
+// Returns the path of the character's picture, or an empty string if they do not have one
+QString ViewCharacter::picturePath()
+{
+    QString imageDir = QDir::currentPath() + "/data/characters/" + characterName + "/";
+    for (const QString &ext : imageExtentions)
+    {
+        if (QFile::exists(imageDir + "character." + ext))
         {
-            qDebug() << "Failed to load image:" << newFileName;
+            return imageDir + "character." + ext;
         }
-
-        // Load and display the new image
-        loadPicture(newFileName);
     }
+    return QString();
 }
 
 // The function to load and display the picture
@@ -331,39 +378,15 @@ void ViewCharacter::loadPicture(const QString &imagePath)
 {
     if (!imagePath.isEmpty())
     {
-        QPixmap characterPicture(imagePath);
+        // The picture is decoded, cropped to 2:3, and scaled on the thread pool
+        // and swapped in by portraitLoader once it is ready
         const int maxWidth = 200;  // Max width
         const int maxHeight = 300; // Max height
-
-        if (!characterPicture.isNull())
+        if (!pictureLoaded)
         {
-            // Calculate the target aspect ratio (2:3)
-            const float targetAspectRatio = 2.0 / 3.0;
-            const float currentAspectRatio = static_cast<float>(characterPicture.width()) / characterPicture.height();
-            QRect cropRect;
-
-            if (currentAspectRatio > targetAspectRatio)
-            {
-                // If the image is wider than the target aspect ratio, crop the sides
-                int newWidth = static_cast<int>(targetAspectRatio * characterPicture.height());
-                int xOffset = (characterPicture.width() - newWidth) / 2; // Center crop
-                cropRect = QRect(xOffset, 0, newWidth, characterPicture.height());
-            }
-            else
-            {
-                // If the image is taller than the target aspect ratio, crop the top and bottom
-                int newHeight = static_cast<int>(characterPicture.width() / targetAspectRatio);
-                int yOffset = (characterPicture.height() - newHeight) / 2; // Center crop
-                cropRect = QRect(0, yOffset, characterPicture.width(), newHeight);
-            }
-
-            // Crop and scale the image
-            QPixmap croppedPicture = characterPicture.copy(cropRect);
-            QPixmap scaledPicture = croppedPicture.scaled(maxWidth, maxHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-            // Set the pixmap to the label
-            pictureLabel->setPixmap(scaledPicture);
+            pictureLabel->setText("Loading..."); // Otherwise keep showing the old picture until the new one is ready
         }
+        portraitLoader->load(imagePath, QSize(maxWidth, maxHeight));
     }
     else
     {
@@ -379,48 +402,44 @@ void ViewCharacter::loadEquippedItems()
     equippedItemsList->setFocusPolicy(Qt::NoFocus);                        // Disable focus
     equippedItemsList->setEditTriggers(QAbstractItemView::NoEditTriggers); // Disable editing
     equippedItemsList->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
-    // Load the character's inventory
-    QString characterName = name;
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/inventory.csv";
-
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        qWarning() << "Failed to open inventory file for loading:" << filePath;
-        return;
-    }
-
-    QTextStream in(&file);
     equippedItemsList->clear();
 
-    while (!in.atEnd())
+    // The inventory model is already in memory and kept current by the inventory page
+    for (const InventoryItem &item : inventory->items())
     {
-        QString line = in.readLine().trimmed();
-        QStringList fields = line.split(",");
-        if (fields.size() < 4)
+        if (item.equipped)
         {
-            qWarning() << "Invalid inventory line:" << line;
-            continue; // Skip invalid lines
-        }
-
-        QString itemName = fields[0];
-        int quantity = fields[1].toInt();
-        int equipped = fields[2].toInt();
-        int attunement = fields[3].toInt();
-
-        if (equipped)
-        {
-            QListWidgetItem *item = new QListWidgetItem("(" + QString::number(quantity) + ") " + itemName);
-            item->setData(Qt::UserRole, line); // Store full data string in UserRole
-            if (attunement)
+            QListWidgetItem *listItem = new QListWidgetItem("(" + QString::number(item.quantity) + ") " + item.name);
+            listItem->setData(Qt::UserRole, item.toLine()); // Store full data string in UserRole
+            if (item.attuned)
             {
-                item->setText(item->text() + " [Attuned]");
+                listItem->setText(listItem->text() + " [Attuned]");
             }
-            equippedItemsList->addItem(item);
+            equippedItemsList->addItem(listItem);
         }
     }
+}
 
-    file.close();
+// Reads inventory.csv into the inventory model, only done when the page is created
+void ViewCharacter::loadInventory()
+{
+    bool ok = false;
+    const QStringList lines = CharacterStorage::instance().readLines(name, "inventory.csv", &ok);
+    if (!ok)
+    {
+        qWarning() << "Failed to open inventory file for loading:" << name;
+        return;
+    }
+    inventory->setLines(lines);
+}
+
+void ViewCharacter::saveInventory()
+{
+    inventorySaveTimer->stop();
+    if (!CharacterStorage::instance().writeLines(name, "inventory.csv", inventory->toLines()))
+    {
+        qWarning() << "Failed to open inventory file for saving:" << name;
+    }
 }
 
 // Function to load the prepped spells into the prepped spells list
@@ -428,138 +447,60 @@ void ViewCharacter::loadPreppedSpells()
 {
     // Load the character's inventory
     QString characterName = name;
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/spells.csv";
-
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    bool ok = false;
+    QByteArray spellsData = CharacterStorage::instance().read(characterName, "spells.csv", &ok);
+    if (!ok)
     {
-        qWarning() << "Failed to open spells file for loading:" << filePath;
+        qWarning() << "Failed to open spells file for loading:" << characterName;
         return;
     }
 
-    QTextStream in(&file);
+    QTextStream in(&spellsData, QIODevice::ReadOnly);
     preppedSpellsList->clear();
 
+    // Compendium spells are stored as just their name, the compendium fills in the rest
+    const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
     while (!in.atEnd())
     {
         QString line = in.readLine().trimmed();
-        QStringList fields = line.split(",");
-        if (fields.size() < 13)
+        bool lineOk = false;
+        SpellRecord spell = compendium.read(line, &lineOk);
+        if (!lineOk)
         {
             qWarning() << "Invalid spell line:" << line;
             continue; // Skip invalid lines
         }
 
-        QString spellName = fields[0];
-        int isPrepared = fields[11].toInt();
-
-        if (isPrepared)
+        if (spell.prepared)
         {
-            QListWidgetItem *item = new QListWidgetItem(spellName);
+            QListWidgetItem *item = new QListWidgetItem(spell.name);
             item->setData(Qt::UserRole, line); // Store full data string in UserRole
             preppedSpellsList->addItem(item);
         }
     }
-
-    file.close();
-}
-
-void ViewCharacter::loadFeatures()
-{
-    qDebug() << "In loadFeatures";
-    QFile file("data/databases/" + characterClass + ".tsv"); // read in the file
-    qDebug() << "Current working directory:" << QDir::currentPath();
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        // error checking for debugging
-        std::cerr << "Failed to open file" << std::endl;
-        return;
-    }
-
-    QTextStream in(&file); // read in the file
-    bool isHeader = true;  // our first line is a header
-
-    while (!in.atEnd())
-    {
-        QString line = in.readLine(); // read in the line
-        if (isHeader)
-        {
-            isHeader = false; // we are no longer on the header
-            continue;         // skip the header
-        }
-
-        QStringList fields = line.split("\t"); // split the line by \t
-
-        // Fill out info
-        FeatureInfo *info = new FeatureInfo{
-            fields[1],
-            fields[2],
-            fields[3].toInt(),
-            fields[4]};
-
-        this->featureList.append(info);
-    }
-}
-
-void ViewCharacter::loadFeats()
-{
-    qDebug() << "In loadFeats";
-    QFile file("data/databases/Feats.tsv"); // read in the file
-    qDebug() << "Current working directory:" << QDir::currentPath();
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        // error checking for debugging
-        std::cerr << "Failed to open file" << std::endl;
-        return;
-    }
-
-    QTextStream in(&file); // read in the file
-    bool isHeader = true;  // our first line is a header
-
-    while (!in.atEnd())
-    {
-        QString line = in.readLine(); // read in the line
-        if (isHeader)
-        {
-            isHeader = false; // we are no longer on the header
-            continue;         // skip the header
-        }
-
-        QStringList fields = line.split("\t"); // split the line by \t
-
-        QString featName = fields[0];
-
-        // Fill out info
-        FeatInfo *info = new FeatInfo{
-            fields[1],
-            fields[2].toInt(),
-            fields[3],
-            fields[4],
-            fields[5],
-            fields[6],
-            fields[7]};
-
-        this->featList[featName] = info;
-        // qDebug() << fields[0];
-        // qDebug() << fields[1];
-        // qDebug() << fields[2];
-        // qDebug() << fields[3];
-        // qDebug() << fields[4];
-        // qDebug() << fields[5];
-        // qDebug() << fields[6];
-        // qDebug() << fields[7];
-    }
 }
 
 ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent), pictureLabel(new ClickableLabel(this))
 {
+    this->name = nameIn;
     loadCharacter(nameIn);
-    loadFeatures();
-    loadFeats();
     // printCharacterToConsole();
-    evaluateCharacterModifiers();
+    buildStatGraph();
+
+    // Inventory edits are saved once they stop coming, and equip toggles update the armor class
+    inventorySaveTimer = new QTimer(this);
+    inventorySaveTimer->setSingleShot(true);
+    inventorySaveTimer->setInterval(500);
+    connect(inventorySaveTimer, &QTimer::timeout, this, &ViewCharacter::saveInventory);
+    connect(inventory, &InventoryModel::edited, inventorySaveTimer, QOverload<>::of(&QTimer::start));
+    connect(inventory, &InventoryModel::itemEquipped, this, &ViewCharacter::equipItem);
+    connect(inventory, &InventoryModel::modelReset, this, &ViewCharacter::rebuildArmorClass);
+    // The equipped list follows the shared model, so returning from the inventory page reads nothing
+    connect(inventory, &InventoryModel::edited, this, &ViewCharacter::loadEquippedItems);
+    connect(inventory, &InventoryModel::modelReset, this, &ViewCharacter::loadEquippedItems);
+    loadInventory();
 
-    this->name = nameIn;
+    evaluateCharacterModifiers();
     // Create the verticle layout for buttons
     QVBoxLayout *layout = new QVBoxLayout(this);
 
@@ -578,20 +519,20 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
     column1Layout->setSpacing(5);
     column1Layout->setContentsMargins(0, 0, 0, 0);
 
-    // Create the character picture
-    QString imageDir = QDir::currentPath() + "/data/characters/" + characterName + "/";
-    QString imagePath;
-    for (const QString &ext : imageExtentions)
-    {
-        if (QFile::exists(imageDir + "character." + ext))
-        {
-            imagePath = imageDir + "character." + ext;
-            break;
-        }
-    }
+    // Create the character picture, it is shown once the background decode is ready
+    connect(portraitLoader, &PortraitLoader::loaded, this, [this](const QPixmap &pixmap)
+            {
+                pictureLabel->setPixmap(pixmap);
+                pictureLoaded = true;
+            });
+    connect(portraitLoader, &PortraitLoader::failed, this, [this]()
+            {
+                pictureLabel->setText("Image not available");
+                pictureLoaded = false;
+            });
 
     // Load and display the picture
-    loadPicture(imagePath);
+    loadPicture(picturePath());
 
     // Define all of the column 1 widgets
     QLabel *nameAndLevelLabel = new QLabel(characterName + " | Level " + QString::number(characterLevel));            // Creates a label for the character's name and level
@@ -700,35 +641,21 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
         statsLayout->addWidget(new QLabel(abilitiesNames[i]), 0, i + 1); // Adds the ability names to the list
     }
 
-    QLabel *strLabel = new QLabel(QString::number(characterAbilities[0]));
-    QLabel *dexLabel = new QLabel(QString::number(characterAbilities[1]));
-    QLabel *conLabel = new QLabel(QString::number(characterAbilities[2]));
-    QLabel *intLabel = new QLabel(QString::number(characterAbilities[3]));
-    QLabel *wisLabel = new QLabel(QString::number(characterAbilities[4]));
-    QLabel *chaLabel = new QLabel(QString::number(characterAbilities[5]));
-    statsLayout->addWidget(strLabel, 1, 1);
-    statsLayout->addWidget(dexLabel, 1, 2);
-    statsLayout->addWidget(conLabel, 1, 3);
-    statsLayout->addWidget(intLabel, 1, 4);
-    statsLayout->addWidget(wisLabel, 1, 5);
-    statsLayout->addWidget(chaLabel, 1, 6);
-
-    // Add ability modifiers below ability scores
-    for (int i = 0; i < characterAbilityBonuses.length(); i++)
-    {
-        QString prefix = ""; // Creates a prefix for the modifier
-        if (characterSavingThrows[i] >= 0)
-            prefix = "+";                                                                                   // Adds a plus sign to the front of the modifier if it is positive or zero
-        statsLayout->addWidget(new QLabel(prefix + QString::number(characterAbilityBonuses[i])), 2, i + 1); // Adds the ability modifiers to the list
-    }
-
-    // Add the saving throws to the stats widget
+    // Each label is bound to its node in the stat graph, which sets its text now and whenever that stat changes
     for (int i = 0; i < abilitiesNames.length(); i++)
     {
-        QString prefix = ""; // Creates a prefix for the saving throw
-        if (characterSavingThrows[i] >= 0)
-            prefix = "+";                                                                                 // Adds a plus sign to the front of the saving throw if it is positive or zero
-        statsLayout->addWidget(new QLabel(prefix + QString::number(characterSavingThrows[i])), 3, i + 1); // Adds the saving throws to the list
+        QLabel *scoreLabel = new QLabel();
+        QLabel *modifierLabel = new QLabel();
+        QLabel *savingThrowLabel = new QLabel();
+        stats.bind(statNodes.ability[i], [scoreLabel](int score)
+                   { scoreLabel->setText(QString::number(score)); });
+        stats.bind(statNodes.modifier[i], [modifierLabel](int modifier)
+                   { modifierLabel->setText(signedNumber(modifier)); });
+        stats.bind(statNodes.savingThrow[i], [savingThrowLabel](int savingThrow)
+                   { savingThrowLabel->setText(signedNumber(savingThrow)); });
+        statsLayout->addWidget(scoreLabel, 1, i + 1);       // Adds the ability scores to the list
+        statsLayout->addWidget(modifierLabel, 2, i + 1);    // Adds the ability modifiers to the list
+        statsLayout->addWidget(savingThrowLabel, 3, i + 1); // Adds the saving throws to the list
     }
 
     // Create a skills widget for the second column
@@ -738,18 +665,20 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
     // Add all of the skill widgets to the skills widget
     QLabel *skillsLabel = new QLabel("Skills\n");                                                                     // Creates a label for the skills section header
     skillsLabel->setAlignment(Qt::AlignLeft);                                                                         // Aligns the skills label to the left
-    QLabel *proficiencyBonusLabel = new QLabel("Proficiency Bonus:\n+" + QString::number(characterProficiencyBonus)); // Adds the proficiency bonus to the label
+    QLabel *proficiencyBonusLabel = new QLabel();                                                                     // Adds the proficiency bonus to the label
+    stats.bind(statNodes.proficiencyBonus, [proficiencyBonusLabel](int bonus)
+               { proficiencyBonusLabel->setText("Proficiency Bonus:\n+" + QString::number(bonus)); });
     proficiencyBonusLabel->setAlignment(Qt::AlignRight);                                                              // Aligns the proficiency bonus label to the right
     skillsLayout->addWidget(skillsLabel, 0, 0);                                                                       // Adds the skills label to the list
     skillsLayout->addWidget(proficiencyBonusLabel, 0, 1, 1, 2);                                                       // Adds the proficiency bonus label to the list
     for (int i = 0; i < skillMap.count(); i++)
     {
-        QString prefix = "";
-        if (characterSkillBonuses[i] >= 0)
-            prefix = "+";                                                                                                   // Adds a plus sign to the front of the skill bonus if it is positive or zero
-        QLabel *skillLabel = new QLabel(skillMap.keys().at(i) + "\n" + prefix + QString::number(characterSkillBonuses[i])); // Uses the skill map to get the skill name and adds the skill bonus to the label
-        skillLabel->setAlignment(Qt::AlignCenter);                                                                          // Aligns the skill label to the center
-        skillsLayout->addWidget(skillLabel, (i / 3) + 1, i % 3);                                                            // Adds the skill label to the list
+        QString skillName = skillMap.keys().at(i);
+        QLabel *skillLabel = new QLabel();
+        stats.bind(statNodes.skill[i], [skillLabel, skillName](int bonus)
+                   { skillLabel->setText(skillName + "\n" + signedNumber(bonus)); }); // Uses the skill map to get the skill name and adds the skill bonus to the label
+        skillLabel->setAlignment(Qt::AlignCenter);                                   // Aligns the skill label to the center
+        skillsLayout->addWidget(skillLabel, (i / 3) + 1, i % 3);                     // Adds the skill label to the list
     }
 
     // Add the stats widget to column 2
@@ -764,9 +693,12 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
     QWidget *combatStatsWidget = new QWidget();                          // Creates a widget for the combat stats section
     QGridLayout *combatStatsLayout = new QGridLayout(combatStatsWidget); // Creates a grid layout for the combat stats section
     // combatStatsWidget->setFixedHeight(100); // Sets the height of the combat stats widget to 100px
-    QString initiativePrefix = (characterInitiative < 0) ? "" : "+";                                                                           // Uses a ternary operator to determine if the initiative is negative or positive
-    QLabel *initiativeLabel = new QLabel("Initiative:\n" + initiativePrefix + QString::number(characterInitiative));                           // Creates a label with the prefix and initiative as the text
-    QLabel *armorClassLabel = new QLabel("Armor Class:\n" + QString::number(characterArmorClass));                                             // Creates a label with the armor class as the text
+    QLabel *initiativeLabel = new QLabel();                                                                                                    // Creates a label for the initiative
+    QLabel *armorClassLabel = new QLabel();                                                                                                    // Creates a label for the armor class
+    stats.bind(statNodes.initiative, [initiativeLabel](int initiative)
+               { initiativeLabel->setText("Initiative:\n" + signedNumber(initiative)); });
+    stats.bind(statNodes.armorClass, [armorClassLabel](int value)
+               { armorClassLabel->setText("Armor Class:\n" + QString::number(value)); });
     QLabel *hitPointsLabel = new QLabel("Hit Points:\n" + QString::number(characterHitPoints) + "/" + QString::number(characterMaxHitPoints)); // Creates a label with the hit points as the text
 
     // Allign the labels to the center
@@ -865,6 +797,14 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
     combatStatsLayout->addWidget(armorClassLabel, 0, 2, 1, 2);
     combatStatsLayout->addWidget(hitPointsLabel, 0, 4, 1, 2);
     combatStatsLayout->addWidget(deathSavingThrows, 1, 3, 1, 3);
+    if (statNodes.spellSaveDC >= 0)
+    {
+        QLabel *spellSaveDCLabel = new QLabel();
+        spellSaveDCLabel->setAlignment(Qt::AlignCenter);
+        stats.bind(statNodes.spellSaveDC, [spellSaveDCLabel](int dc)
+                   { spellSaveDCLabel->setText("Spell Save DC:\n" + QString::number(dc)); });
+        combatStatsLayout->addWidget(spellSaveDCLabel, 1, 0, 1, 3);
+    }
 
     // Add the column 3 widgets to column 3
     column3Layout->addWidget(combatStatsWidget);
@@ -975,7 +915,7 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
     connect(pictureLabel, &ClickableLabel::clicked, this, &ViewCharacter::changeProfilePicture);
 
     // connect level up button to levelUp function
-    connect(levelUpButton, &QPushButton::clicked, [this, experienceProgressBar, experienceLow, experienceHigh, nameAndLevelLabel, strLabel, dexLabel, conLabel, intLabel, wisLabel, chaLabel, hitPointsLabel]()
+    connect(levelUpButton, &QPushButton::clicked, [this, experienceProgressBar, experienceLow, experienceHigh, nameAndLevelLabel, hitPointsLabel]()
             {
         levelUp();
         experienceProgressBar->setRange(experienceTable[characterLevel - 1], experienceTable[characterLevel]);
@@ -983,13 +923,8 @@ ViewCharacter::ViewCharacter(QWidget *parent, QString nameIn) : QWidget(parent),
         experienceLow->setText(QString::number(experienceTable[characterLevel - 1]));
         experienceHigh->setText(QString::number(experienceTable[characterLevel]));
 
+        // The ability scores and everything derived from them are relabeled by the stat graph
         nameAndLevelLabel->setText(characterName + " | Level " + QString::number(characterLevel));
-        strLabel->setText(QString::number(characterAbilities[0]));
-        dexLabel->setText(QString::number(characterAbilities[1]));
-        conLabel->setText(QString::number(characterAbilities[2]));
-        intLabel->setText(QString::number(characterAbilities[3]));
-        wisLabel->setText(QString::number(characterAbilities[4]));
-        chaLabel->setText(QString::number(characterAbilities[5])); 
         hitPointsLabel->setText("Hit Points:\n" + QString::number(characterHitPoints) + "/" + QString::number(characterMaxHitPoints)); });
 
     // connect add experience button to addExperience function
@@ -1150,44 +1085,13 @@ void ViewCharacter::animateLabelBackground(QLabel *label)
 void ViewCharacter::saveCoins()
 {
     // Saves coins to the character's character.csv file
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/character.csv"; // Creates a file path for the character's character.csv file
-    QFile file(filePath);                                                                            // Creates a file object for the character's character.csv file
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        qWarning() << "Failed to open character file for saving coins:" << filePath; // Outputs a warning if the file fails to open
-        return;
-    }
-
-    QTextStream in(&file); // Create a text stream to read the file
-    QStringList lines;     // Create a list of strings to store the lines of the file
-    while (!in.atEnd())
-    {
-        lines.append(in.readLine()); // Read each line of the file
-    }
-
     QString coins = QString::number(characterCoins[0]) + "," +
                     QString::number(characterCoins[1]) + "," +
                     QString::number(characterCoins[2]) + "," +
                     QString::number(characterCoins[3]); // Creates a string for the coins
 
-    lines[5] = coins; // Update the coins line
-
-    file.close(); // Close the file
-
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        qWarning() << "Failed to open character file for saving coins:" << filePath;
-        return;
-    }
-
-    QTextStream out(&file); // Create a text stream to write to the file
-
-    for (const QString &line : lines)
-    {
-        out << line << "\n"; // Write each line to the file
-    }
-
-    file.close(); // Close the file
+    characterFile.setRecord(CharacterFile::Coins, coins); // Update the coins line
+    scheduleCommit();
 }
 
 void ViewCharacter::goBack()
@@ -1225,10 +1129,7 @@ void ViewCharacter::levelUp()
 
     if (isSpellcaster())
     {
-        for (int i = 0; i < 2; i++)
-        {
-            addSpell();
-        }
+        addSpells(2);
     }
 
     QDialog popup;
@@ -1237,14 +1138,16 @@ void ViewCharacter::levelUp()
 
     QVBoxLayout layout(&popup);
 
-    for (int i = 0; i < featureList.size(); ++i)
+    // Class features are parsed once by the shared database
+    const ReferenceDatabase &database = ReferenceDatabase::instance();
+    const QList<FeatureInfo> &featureList = database.features(characterClass);
+    for (const FeatureInfo &info : featureList)
     {
         // List of new features from level up
-        FeatureInfo *info = featureList[i];
-        if (info->level == characterLevel && (info->subClass == characterSubclass || info->subClass == "Base"))
+        if (info.level == characterLevel && (info.subClass == characterSubclass || info.subClass == "Base"))
         {
-            QString feature = info->featureName;
-            QString description = info->description;
+            QString feature = info.featureName;
+            QString description = info.description;
             QLabel *featureLabel = new QLabel(feature);
             QLabel *descriptionLabel = new QLabel(description);
             descriptionLabel->setWordWrap(true);
@@ -1253,11 +1156,11 @@ void ViewCharacter::levelUp()
         }
     }
 
-    if (this->abilityScoreImprovementLevels.contains(characterLevel) && characterLevel != 4)
+    if (this->abilityScoreImprovementLevels.contains(characterLevel) && characterLevel != 4 && featureList.size() > 2)
     {
         // For ability score improvement levels above 4
-        QString feature = featureList[2]->featureName;
-        QString description = featureList[2]->description;
+        QString feature = featureList[2].featureName;
+        QString description = featureList[2].description;
         QLabel *featureLabel = new QLabel(feature);
         QLabel *descriptionLabel = new QLabel(description);
         descriptionLabel->setWordWrap(true);
@@ -1265,18 +1168,19 @@ void ViewCharacter::levelUp()
         layout.addWidget(descriptionLabel);
     }
 
-    // Choose feat
+    // Choose feat, typing into the box ranks every feat against the text so there is no need to scroll
     QComboBox *featComboBox = new QComboBox();
+    FuzzyCompleter *featCompleter = new FuzzyCompleter(database.feats().keys(), featComboBox);
     if (this->abilityScoreImprovementLevels.contains(characterLevel))
     {
 
         featComboBox->setStyleSheet("QComboBox { combobox-popup: 0; }");
         featComboBox->setMaxVisibleItems(10);
 
-        for (auto it = featList.begin(); it != featList.end(); ++it)
-        {
-            featComboBox->addItem(it.key());
-        }
+        featComboBox->addItems(database.feats().keys());
+        featComboBox->setEditable(true);
+        featComboBox->setInsertPolicy(QComboBox::NoInsert);
+        featCompleter->attach(featComboBox->lineEdit());
         layout.addWidget(featComboBox);
     }
 
@@ -1312,224 +1216,60 @@ void ViewCharacter::levelUp()
         if (this->abilityScoreImprovementLevels.contains(characterLevel))
         {
             // Update feats or ability scores
-            QString feat = featComboBox->currentText();
-            FeatInfo *info = featList[feat];
-            QStringList abilityScoreImprovements = info->abilityScoreImprovements.split(":");
-            for (int i = 0; i < characterAbilities.size(); ++i)
+            // Text that is not a feat name stands for the feat it matches best
+            QString feat = featCompleter->bestMatch(featComboBox->currentText());
+            const FeatInfo *info = database.featInfo(feat);
+            QStringList abilityScoreImprovements = info ? info->abilityScoreImprovements.split(":") : QStringList();
+            for (int i = 0; i < characterAbilities.size() && i < abilityScoreImprovements.size(); ++i)
             {
                 characterAbilities[i] += abilityScoreImprovements[i].toInt();
             }
-            characterFeats.append(feat);
+            if (info)
+            {
+                characterFeats.append(feat);
+            }
         }
         // Update max hp
         characterMaxHitPoints += hpEdit->value();
         // Save to csv
         saveCharacterStatsAndFeats();
     }
+
+    // Only the stats that depend on the new level or ability scores are recomputed and relabeled
+    evaluateCharacterModifiers();
 }
 
-void ViewCharacter::addSpell()
+void ViewCharacter::addSpells(int count)
 {
-    qDebug() << "In addSpell";
-    QDialog popup;
-
-    popup.setWindowModality(Qt::ApplicationModal); // stios the user from interacting with the main window while the popup is open
-    popup.setWindowTitle("Add Spell");             // set the title of the popup
-
-    QLabel *popupHeader = new QLabel("Add Spell"); // creates the header text for the popup
-
-    QLabel *bookLabel = new QLabel("Book Abbreviation:");
-    QLineEdit *book = new QLineEdit();
-
-    QLabel *pageLabel = new QLabel("Page:");
-    QSpinBox *page = new QSpinBox();
-    page->setMaximum(999);
-
-    // spell attributes and labels
-    QLabel *nameLabel = new QLabel("Name"); // label for textbox
-    QLineEdit *spellName = new QLineEdit();
-
-    QLabel *levelLabel = new QLabel("Level");
-    QSpinBox *level = new QSpinBox();
-    level->setRange(0, 9);
-
-    QLabel *schoolLabel = new QLabel("School of Magic");
-    QLineEdit *school = new QLineEdit();
-
-    QLabel *timeLabel = new QLabel("Casting Time");
-    QLineEdit *time = new QLineEdit();
-
-    QLabel *rangeLabel = new QLabel("Range");
-    QLabel *minRangeLabel = new QLabel("Min");
-    QLabel *maxRangeLabel = new QLabel("Max");
-    QSpinBox *minRange = new QSpinBox();
-    QSpinBox *maxRange = new QSpinBox();
-    maxRange->setMaximum(360);
-
-    QLabel *componentsLabel = new QLabel("Components");
-    QLabel *verbalLabel = new QLabel("Verbal");
-    QLabel *somaticLabel = new QLabel("Somatic");
-    QLabel *materialLabel = new QLabel("Material");
-    QCheckBox *verbal = new QCheckBox();
-    QCheckBox *somatic = new QCheckBox();
-    QCheckBox *material = new QCheckBox();
-
-    QLabel *durationLabel = new QLabel("Duration");
-    QLineEdit *duration = new QLineEdit();
-
-    QLabel *concentrationLabel = new QLabel("Concentration");
-    QCheckBox *concentration = new QCheckBox();
-
-    QLabel *ritualLabel = new QLabel("Ritual");
-    QCheckBox *ritual = new QCheckBox();
-
-    QLabel *descriptionLabel = new QLabel("Description");
-    QTextEdit *description = new QTextEdit();
-
-    // create the buttons for the popup
-    QPushButton *popupConfirm = new QPushButton("Confirm"); // creates the confirm button
-    QPushButton *popupCancel = new QPushButton("Cancel");   // creates the cancel button
-
-    // Gets rid of the padding around the text of the buttons
-    popupConfirm->setStyleSheet("padding: 5px 0px; margin: 0px;");
-    popupCancel->setStyleSheet("padding: 5px 0px; margin: 0px;");
-
-    // Connect the confirm button to accept the dialog (e.g., confirming the deletion)
-    QObject::connect(popupConfirm, &QPushButton::clicked, &popup, &QDialog::accept);
-
-    // Connect the cancel button to reject the dialog (e.g., canceling the deletion)
-    QObject::connect(popupCancel, &QPushButton::clicked, &popup, &QDialog::reject);
-
-    // create the layout for the popup
-    QVBoxLayout *popupLayout = new QVBoxLayout(&popup);
-
-    // create the layout for the header of the popup
-    QHBoxLayout *popupHeaderLayout = new QHBoxLayout();
-
-    // creates the layout for the body of the popup
-    QGridLayout *popupBodyLayout = new QGridLayout();
-
-    // Create button widget
-    QHBoxLayout *popupButtonLayout = new QHBoxLayout();
-
-    // adds the header components to the header layout
-    popupHeaderLayout->addWidget(popupHeader);
-    popupBodyLayout->addWidget(bookLabel, 0, 0, 1, 1, {Qt::AlignLeft});
-    popupBodyLayout->addWidget(book, 0, 1, 1, 1, {Qt::AlignLeft});
-    popupBodyLayout->addWidget(pageLabel, 0, 2, 1, 1, {Qt::AlignLeft});
-    popupBodyLayout->addWidget(page, 0, 3, 1, 1, {Qt::AlignLeft});
-
-    // adds the attributes to the body layout
-    popupBodyLayout->addWidget(nameLabel, 1, 0, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(spellName, 2, 0, 2, 1);
-
-    popupBodyLayout->addWidget(levelLabel, 1, 1, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(level, 2, 1, 2, 1);
-
-    popupBodyLayout->addWidget(schoolLabel, 1, 2, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(school, 2, 2, 2, 1);
-
-    popupBodyLayout->addWidget(timeLabel, 1, 3, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(time, 2, 3, 2, 1);
-
-    popupBodyLayout->addWidget(rangeLabel, 1, 4, 1, 2, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(minRangeLabel, 2, 4, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(minRange, 3, 4, 1, 1);
-    popupBodyLayout->addWidget(maxRangeLabel, 2, 5, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(maxRange, 3, 5, 1, 1);
-
-    popupBodyLayout->addWidget(componentsLabel, 1, 6, 1, 3, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(verbalLabel, 2, 6, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(verbal, 3, 6, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(somaticLabel, 2, 7, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(somatic, 3, 7, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(materialLabel, 2, 8, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(material, 3, 8, 1, 1, {Qt::AlignCenter});
-
-    popupBodyLayout->addWidget(durationLabel, 1, 9, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(duration, 2, 9, 2, 1);
-
-    popupBodyLayout->addWidget(concentrationLabel, 1, 10, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(concentration, 2, 10, 2, 1, {Qt::AlignCenter});
-
-    popupBodyLayout->addWidget(ritualLabel, 1, 11, 1, 1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(ritual, 2, 11, 2, 1, {Qt::AlignCenter});
-
-    popupBodyLayout->addWidget(descriptionLabel, 4, 0, 1, -1, {Qt::AlignCenter});
-    popupBodyLayout->addWidget(description, 5, 0, -1, -1);
-
-    // adds the buttons to the button layout
-    popupButtonLayout->addWidget(popupConfirm);
-    popupButtonLayout->addWidget(popupCancel);
+    qDebug() << "In addSpells";
 
-    // adds the components to the popup
-    popupLayout->addLayout(popupHeaderLayout);
-    popupLayout->addLayout(popupBodyLayout);
-    popupLayout->addLayout(popupButtonLayout);
-
-    // makes the popup text take up more horizontal space
-    popupLayout->setStretch(0, 1);
-
-    // show the popup
-    popup.exec();
+    // Spells the character already knows are left out of the dialog
+    QStringList known;
+    const SpellCompendium &compendium = ReferenceDatabase::instance().spellCompendium();
+    const QStringList lines = CharacterStorage::instance().readLines(characterName, "spells.csv");
+    for (const QString &line : lines)
+    {
+        known.append(compendium.read(line).name);
+    }
 
-    if (popup.result() == QDialog::Accepted)
+    SpellDialog popup(count, characterClass, characterLevel, known, this);
+    if (popup.exec() != QDialog::Accepted)
     {
-        // this->spellsList->addItem(spellName->text());
-        SpellInfo *info = new SpellInfo;
-        info->spellName = spellName->text();
-        info->book = book->text();
-        info->page = page->value();
-        info->level = level->value();
-        info->school = school->text();
-        info->time = time->text();
-        info->minRange = minRange->value();
-        info->maxRange = maxRange->value();
-        info->verbal = verbal->isChecked();
-        info->somatic = somatic->isChecked();
-        info->material = material->isChecked();
-        info->duration = duration->text();
-        info->concentration = concentration->isChecked();
-        info->ritual = ritual->isChecked();
-        QString desc = description->toPlainText();
-        QRegularExpression re("\n");
-        desc.replace(re, "<br>");
-        info->description = desc;
-        // (*this->spells)[spellName->text()] = info;
-        this->saveSpell(info);
+        return;
     }
 
-    // this is so that no spell is selected after creation
-    // this->spellsList->selectionModel()->clear();
-    // this->removeSpellButton->setEnabled(false);
+    for (const SpellRecord &spell : popup.chosenSpells())
+    {
+        this->saveSpell(spell);
+    }
 }
 
-void ViewCharacter::saveSpell(SpellInfo *info)
+void ViewCharacter::saveSpell(const SpellRecord &spell)
 {
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/spells.csv"; // Creates a file path for the character's spell.csv file
-
-    QFile spellsFile(filePath);
-
-    if (spellsFile.open(QIODevice::WriteOnly | QIODevice::Append))
+    QString line = ReferenceDatabase::instance().spellCompendium().write(spell);
+    if (!CharacterStorage::instance().appendLine(characterName, "spells.csv", line))
     {
-        QTextStream out(&spellsFile);
-
-        out << info->spellName << "," << info->book << "," << info->page << "," << info->level << "," << info->school << "," << info->time << "," << info->maxRange << ",";
-        if (info->verbal)
-        {
-            out << "v";
-        }
-        if (info->somatic)
-        {
-            out << "s";
-        }
-        if (info->material)
-        {
-            out << "m";
-        }
-        out << "," << info->duration << "," << info->concentration << "," << info->ritual << ",false," << info->description << Qt::endl;
-
-        spellsFile.close();
+        qWarning() << "Failed to save spell:" << spell.name;
     }
 }
 
@@ -1591,22 +1331,6 @@ void ViewCharacter::addExperience()
 
 void ViewCharacter::saveCharacterStatsAndFeats()
 {
-    // Saves experience to the character's character.csv file
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/character.csv"; // Creates a file path for the character's character.csv file
-    QFile file(filePath);                                                                            // Creates a file object for the character's character.csv file
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        qWarning() << "Failed to open character file for saving experience:" << filePath; // Outputs a warning if the file fails to open
-        return;
-    }
-
-    QTextStream in(&file); // Create a text stream to read the file
-    QStringList lines;     // Create a list of strings to store the lines of the file
-    while (!in.atEnd())
-    {
-        lines.append(in.readLine()); // Read each line of the file
-    }
-
     // Create string for the character stats
     QString characterStats = characterName + ",";
 
@@ -1622,24 +1346,100 @@ void ViewCharacter::saveCharacterStatsAndFeats()
                       characterRace + "," +
                       characterSubrace;
 
-    lines[0] = characterStats; // Update the character stats line
+    characterFile.setRecord(CharacterFile::Stats, characterStats); // Update the character stats line
+    characterFile.setList(CharacterFile::Feats, characterFeats);   // Update the feats line
+    scheduleCommit();
+}
 
-    file.close(); // Close the file
+// Edits made during one action (ex. adding XP that levels the character up) are saved together once it finishes
+void ViewCharacter::scheduleCommit()
+{
+    if (commitPending)
+    {
+        return;
+    }
+    commitPending = true;
+    QTimer::singleShot(0, this, &ViewCharacter::commitCharacterFile);
+}
 
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+void ViewCharacter::commitCharacterFile()
+{
+    commitPending = false;
+    if (!characterFile.isDirty())
     {
-        qWarning() << "Failed to open character file for saving experience:" << filePath;
         return;
     }
 
-    QTextStream out(&file); // Create a text stream to write to the file
+    if (characterFile.commit())
+    {
+        CharacterIndex::instance().update(name); // Keep the character select list current
+    }
+}
 
-    for (const QString &line : lines)
+QWidget *ViewCharacter::createPlaceholder()
+{
+    QWidget *placeholder = new QWidget();
+    placeholder->setProperty("isPlaceholder", true);
+    return placeholder;
+}
+
+QWidget *ViewCharacter::ensurePage(int index)
+{
+    QStackedWidget *currentStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
+    if (!currentStackedWidget || index <= CharacterPage || index > NotesPage)
     {
-        out << line << "\n"; // Write each line to the file
+        return nullptr;
     }
 
-    file.close(); // Close the file
+    QWidget *page = currentStackedWidget->widget(index);
+    if (page && !page->property("isPlaceholder").toBool())
+    {
+        return page; // Already built
+    }
+
+    // Build the page the first time it is needed so opening a character only pays for this page
+    QWidget *newPage = nullptr;
+    switch (index)
+    {
+    case InventoryPage:
+        newPage = new ViewInventory(nullptr, this->name, this->inventory);
+        break;
+    case SpellsPage:
+        newPage = new ViewSpells(nullptr, this->name);
+        break;
+    case NotesPage:
+        newPage = new ViewNotes(nullptr, this->name);
+        break;
+    }
+
+    if (page)
+    {
+        currentStackedWidget->removeWidget(page);
+        page->deleteLater();
+    }
+    currentStackedWidget->insertWidget(index, newPage);
+    return newPage;
+}
+
+void ViewCharacter::prewarmPages()
+{
+    QStackedWidget *currentStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
+    if (!currentStackedWidget)
+    {
+        return;
+    }
+
+    // Build one page per event loop pass so the sheet stays responsive while the rest are made
+    for (int index = InventoryPage; index <= NotesPage; index++)
+    {
+        QWidget *page = currentStackedWidget->widget(index);
+        if (!page || page->property("isPlaceholder").toBool())
+        {
+            this->ensurePage(index);
+            QTimer::singleShot(0, this, &ViewCharacter::prewarmPages);
+            return;
+        }
+    }
 }
 
 void ViewCharacter::goToInventory()
@@ -1647,7 +1447,12 @@ void ViewCharacter::goToInventory()
     QStackedWidget *currentStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
     if (currentStackedWidget)
     {
-        currentStackedWidget->setCurrentIndex(1); // Switch to Inventory (index 1)
+        ViewInventory *inventory = qobject_cast<ViewInventory *>(this->ensurePage(InventoryPage));
+        if (inventory && !characterAbilities.isEmpty())
+        {
+            inventory->setStrength(characterAbilities[0]); // Carrying limits follow the current Strength score
+        }
+        currentStackedWidget->setCurrentIndex(InventoryPage); // Switch to Inventory (index 1)
     }
 }
 
@@ -1656,7 +1461,8 @@ void ViewCharacter::goToSpells()
     QStackedWidget *currentStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
     if (currentStackedWidget)
     {
-        currentStackedWidget->setCurrentIndex(2); // Switch to Inventory (index 1)
+        this->ensurePage(SpellsPage);
+        currentStackedWidget->setCurrentIndex(SpellsPage); // Switch to Spells (index 2)
     }
 }
 
@@ -1665,12 +1471,18 @@ void ViewCharacter::goToNotes()
     QStackedWidget *currentStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
     if (currentStackedWidget)
     {
-        currentStackedWidget->setCurrentIndex(3); // Switch to Notes (index 2)
+        this->ensurePage(NotesPage);
+        currentStackedWidget->setCurrentIndex(NotesPage); // Switch to Notes (index 3)
     }
 }
 
 ViewCharacter::~ViewCharacter()
 {
+    commitCharacterFile();
+    if (inventorySaveTimer->isActive())
+    {
+        saveInventory(); // Write inventory edits that were still waiting on the timer
+    }
     delete this->proficiencyBonusTable;
     delete this->experienceTable;
 }
@@ -4,7 +4,7 @@ Description: Page to view a character's information, notes, and stats.
 Authors: Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 10/25/2024
-Last Modified: 11/6/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef VIEWCHARACTER_H
@@ -18,6 +18,14 @@ Last Modified: 11/6/2024
 #include <QMouseEvent>
 #include <QListWidget>
 #include "smoothScrollListWidget.h"
+#include "referenceDatabase.h"
+#include "portraitLoader.h"
+#include "characterFile.h"
+#include "inventoryModel.h"
+#include "armorClass.h"
+#include "statGraph.h"
+
+class QTimer;
 
 class ClickableLabel : public QLabel
 {
@@ -49,69 +57,77 @@ public:
     ~ViewCharacter();
     void printCharacterToConsole();
     void loadAll();
+    // Re-reads spells.csv for the prepared spells list, the spells page calls it when it is left
+    void loadPreppedSpells();
     bool isSpellcaster() { return this->spellcasters.contains(this->characterClass); }
 
-private:
-    struct SpellInfo
-    {
-        QString spellName;
-        QString book;
-        int page;
-        int level;
-        QString school;
-        QString time;
-        int minRange;
-        int maxRange;
-        bool verbal;
-        bool somatic;
-        bool material;
-        QString duration;
-        bool concentration;
-        bool ritual;
-        QString description;
-    };
-
-    struct FeatureInfo
+    // Order of the pages in the characterInformation stack
+    enum Page
     {
-        QString subClass;
-        QString featureName;
-        int level;
-        QString description;
+        CharacterPage = 0,
+        InventoryPage = 1,
+        SpellsPage = 2,
+        NotesPage = 3
     };
+    // Empty page that holds a slot in the characterInformation stack until it is first visited
+    static QWidget *createPlaceholder();
+    // Builds the page at index if it is still a placeholder and returns it
+    QWidget *ensurePage(int index);
 
-    struct FeatInfo
-    {
-        QString abilityScoreReqs;
-        int spellcastingReq;
-        QString proficiencyReq;
-        QString book;
-        QString page;
-        QString abilityScoreImprovements;
-        QString description;
-    };
+public slots:
+    void prewarmPages();
 
+private:
     void loadCharacter(QString name);
     void evaluateCharacterModifiers();
     void changeProfilePicture();
     void loadPicture(const QString &imagePath);
+    QString picturePath();
     void loadEquippedItems();
-    void loadPreppedSpells();
-    void loadFeatures();
-    void loadFeats();
+    void loadInventory();
+    void saveInventory();
+    void buildStatGraph();
     void levelUp();
-    void addSpell();
-    void saveSpell(SpellInfo *info);
+    // Opens one dialog to learn up to count spells and appends them to spells.csv
+    void addSpells(int count);
+    void saveSpell(const SpellRecord &spell);
     void addExperience();
     void saveCharacterStatsAndFeats();
     void editCoins();
     void saveCoins();
+    void scheduleCommit();
+    void commitCharacterFile();
     void animateLabelBackground(QLabel *label);
     QList<QString> spellcasters = {"Bard", "Cleric", "Druid", "Paladin", "Ranger", "Sorcerer", "Warlock", "Wizard"};
     QList<int> abilityScoreImprovementLevels = {4, 8, 12, 16, 19};
+    QMap<QString, int> spellcastingAbility = {{"Bard", 5}, {"Cleric", 4}, {"Druid", 4}, {"Paladin", 5}, {"Ranger", 4}, {"Sorcerer", 5}, {"Warlock", 5}, {"Wizard", 3}};
     QMap<QString, int> hitDie = {{"Barbarian", 12}, {"Bard", 8}, {"Cleric", 8}, {"Druid", 8}, {"Fighter", 10}, {"Monk", 8}, {"Paladin", 10}, {"Ranger", 10}, {"Rogue", 8}, {"Sorcerer", 6}, {"Warlock", 8}, {"Wizard", 6}};
-    QList<FeatureInfo *> featureList;
-    QMap<QString, FeatInfo *> featList;
     ClickableLabel *pictureLabel = new ClickableLabel();
+    PortraitLoader *portraitLoader = new PortraitLoader(this);
+    bool pictureLoaded = false;
+    // The character's character.csv, changes to it are saved together once the current action finishes
+    CharacterFile characterFile;
+    bool commitPending = false;
+    // The character's inventory.csv, read once and shared with the inventory page, which edits it in place
+    InventoryModel *inventory = new InventoryModel(this);
+    QTimer *inventorySaveTimer; // Restarted by every edit so a run of clicks is saved once
+    // Kept up to date one equip toggle at a time
+    ArmorClass armorClass;
+    // Derived stats, the labels on the sheet are bound to these nodes and only change when their stat does
+    StatGraph stats;
+    struct StatNodes
+    {
+        int ability[6];
+        int modifier[6];
+        int savingThrow[6];
+        int level;
+        int proficiencyBonus;
+        QVector<int> skillProficient; // in skillMap order
+        QVector<int> skill;
+        int initiative;
+        int armorClass;
+        int spellSaveDC = -1; // -1 for characters that do not cast spells
+    } statNodes;
     QString name;
     QString characterName;
     QString characterClass;
@@ -128,9 +144,6 @@ private:
     QStringList characterEquipmentProficiencies;
     QStringList imageExtentions = {"png", "jpg", "bmp", "jpeg"};
     QList<int> characterAbilities;
-    QList<int> characterAbilityBonuses;
-    QList<int> characterSavingThrows;
-    QList<int> characterSkillBonuses;
     QList<int> characterCoins;
     QList<int> deathThrows;
     SmoothScrollListWidget *equippedItemsList = new SmoothScrollListWidget();
@@ -139,15 +152,14 @@ private:
     int characterHitPoints;
     int characterMaxHitPoints;
     int characterTempHitPoints;
-    int characterArmorClass;
-    int characterInitiative;
     int characterLevel;
     int characterExperience;
-    int characterProficiencyBonus;
     const int *proficiencyBonusTable = new int[20]{2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6};
     const int *experienceTable = new int[21]{0, 300, 900, 2700, 6500, 14000, 23000, 34000, 48000, 64000, 85000, 100000, 120000, 140000, 165000, 195000, 225000, 265000, 305000, 355000, 405000};
 
 private slots:
+    void equipItem(const QString &itemName, bool equipped);
+    void rebuildArmorClass();
     void goBack();
     void goToInventory();
     void goToSpells();
@@ -1,17 +1,21 @@
 /*
 Name: viewInventory.cpp
 Description: Page to view a character's inventory.
-Authors: Zachary Craig, Carson Treece
+Authors: Zachary Craig, Carson Treece, Josh Park
 Other Sources: ...
 Date Created: 11/5/2024
-Last Modified: 12/4/2024
+Last Modified: 10/17/2026
 */
 
 #include "viewInventory.h"
 #include "themeUtils.h"
-#include "viewCharacter.h"
+#include "inventoryModel.h"
+#include "fuzzyCompleter.h"
+#include "referenceDatabase.h"
 
 #include <QVBoxLayout>
+#include <QDialog>
+#include <QItemSelectionModel>
 #include <QPushButton>
 #include <QStackedWidget>
 #include <QList>
@@ -26,59 +30,8 @@ Last Modified: 12/4/2024
 #include <QMessageBox>
 #include <QSpinBox>
 
-void ViewInventory::loadInventory()
-{
-    int selectedIndex = inventoryList->currentRow();
-
-    QString characterName = inventoryLabel->text().remove("'s Inventory");
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/inventory.csv";
-
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open inventory file for loading:" << filePath;
-        return;
-    }
-
-    QTextStream in(&file);
-    inventoryList->clear();
-
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        QStringList fields = line.split(",");
-        if (fields.size() < 4) {
-            qWarning() << "Invalid inventory line:" << line;
-            continue; // Skip invalid lines
-        }
-
-        QString itemName = fields[0];
-        int quantity = fields[1].toInt();
-        int equipped = fields[2].toInt();
-        int attunement = fields[3].toInt();
-
-        if (attunement == 1 && equipped == 1) {
-            itemName.append(" [Equipped & Attuned]");
-        } else if (attunement == 1) {
-            itemName.append(" [Attuned]");
-        } else if (equipped == 1) {
-            itemName.append(" [Equipped]");
-        }
-
-
-        QListWidgetItem *item = new QListWidgetItem("(" + QString::number(quantity) + ") " + itemName);
-        item->setData(Qt::UserRole, line); // Store full data string in UserRole
-        inventoryList->addItem(item);
-    }
-
-    file.close();
-
-    if (selectedIndex >= 0 && selectedIndex < inventoryList->count()) {
-        inventoryList->setCurrentRow(selectedIndex); // Restore the selected index
-    }
-}
-
-
-ViewInventory::ViewInventory(QWidget *parent, QString name) :
-    QWidget(parent)
+ViewInventory::ViewInventory(QWidget *parent, QString name, InventoryModel *inventory) :
+    QWidget(parent), inventory(inventory)
 {
     // Create a row for the navbar
     QWidget *navbar = new QWidget();
@@ -101,8 +54,9 @@ ViewInventory::ViewInventory(QWidget *parent, QString name) :
     QWidget *body = new QWidget();
     QHBoxLayout *bodyLayout = new QHBoxLayout(body); // Horizontal layout for splitting the view
 
-    // Create the inventory list
-    inventoryList = new QListWidget();
+    // Create the inventory list, a view of the model so changing one item repaints only its row
+    inventoryList = new QListView();
+    inventoryList->setModel(inventory);
     inventoryList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding); // Ensure it scales properly
 
     // Add buttons for managing inventory on the right side
@@ -111,8 +65,8 @@ ViewInventory::ViewInventory(QWidget *parent, QString name) :
     QPushButton *deleteItemButton = new QPushButton("Delete Item");
     QPushButton *increaseQuantityButton = new QPushButton("Increase Count");
     QPushButton *decreaseQuantityButton = new QPushButton("Decrease Count");
-    QPushButton *equipItemButton = new QPushButton("Equip Item");
-    QPushButton *attuneItemButton = new QPushButton("Attune Item");
+    equipItemButton = new QPushButton("Equip Item");
+    attuneItemButton = new QPushButton("Attune Item");
 
     // Add buttons to the button layout
     buttonLayout->addWidget(addItemButton);
@@ -123,6 +77,11 @@ ViewInventory::ViewInventory(QWidget *parent, QString name) :
     buttonLayout->addWidget(attuneItemButton);
     buttonLayout->addStretch(); // Add a stretch at the bottom for spacing
 
+    // Show the carried weight under the buttons
+    weightLabel = new QLabel();
+    weightLabel->setWordWrap(true);
+    buttonLayout->addWidget(weightLabel);
+
     // Add the inventory list and buttons to the body layout
     bodyLayout->addWidget(inventoryList, 3); // Inventory list takes 75% of the space
     bodyLayout->addLayout(buttonLayout, 1); // Buttons take 25% of the space
@@ -139,11 +98,37 @@ ViewInventory::ViewInventory(QWidget *parent, QString name) :
     connect(addItemButton, &QPushButton::clicked, this, &ViewInventory::addItem);
     connect(equipItemButton, &QPushButton::clicked, this, &ViewInventory::equipItem);
     connect(attuneItemButton, &QPushButton::clicked, this, &ViewInventory::attuneItem);
-    connect(inventoryList, &QListWidget::itemSelectionChanged, this, [this, equipItemButton, attuneItemButton](){ updateButtons(*equipItemButton, *attuneItemButton); });
+    connect(inventoryList->selectionModel(), &QItemSelectionModel::currentChanged, this, &ViewInventory::updateButtons);
+    connect(inventory, &InventoryModel::dataChanged, this, &ViewInventory::updateButtons);
+    connect(inventory, &InventoryModel::carriedWeightChanged, this, &ViewInventory::updateWeight);
 
     reloadTheme(); // Reload the theme after everything is placed
 
-    loadInventory(); // Load the inventory when the page is initialized
+    updateWeight();
+}
+
+void ViewInventory::setStrength(int score)
+{
+    if (strength != score) {
+        strength = score;
+        updateWeight();
+    }
+}
+
+// Variant encumbrance from the PHB, the totals come from the model so this does not look at the items
+void ViewInventory::updateWeight()
+{
+    double carried = inventory->carriedWeight();
+    QString text = "Carried: " + QString::number(carried) + " / " + QString::number(strength * 15) + " lb";
+
+    if (carried > strength * 15) {
+        text += "\nOver carrying capacity";
+    } else if (carried > strength * 10) {
+        text += "\nHeavily encumbered: speed -20 ft, disadvantage on Str, Dex and Con rolls";
+    } else if (carried > strength * 5) {
+        text += "\nEncumbered: speed -10 ft";
+    }
+    weightLabel->setText(text);
 }
 
 
@@ -151,48 +136,35 @@ void ViewInventory::goBack() {
     QStackedWidget *mainStackedWidget = qobject_cast<QStackedWidget *>(this->parentWidget());
     if (mainStackedWidget)
     {
-        // cast the QWidget from index 0
-        QWidget *viewCharacterWidget = mainStackedWidget->widget(0);
-
-        // call the loadAll() function from viewCharacter which is the QWidget at index 0
-        ViewCharacter *character = qobject_cast<ViewCharacter *>(viewCharacterWidget);
-        if (character)
-        {
-            character->loadAll();
-        }
-
+        // The character page shares the inventory model and updates its equipped list from it
         mainStackedWidget->setCurrentIndex(0); // Switch to ViewCharacter (index 0)
     }
 }
 
 // Update the equip and attune buttons based on the selected item
-void ViewInventory::updateButtons(QPushButton &equipItemButton, QPushButton &attuneItemButton)
+void ViewInventory::updateButtons()
 {
     // Get the selected item
-    QListWidgetItem *item = inventoryList->currentItem();
-    if (!item) return; // Return if no item is selected
+    QModelIndex current = inventoryList->currentIndex();
+    if (!current.isValid()) return; // Return if no item is selected
 
-    QStringList fields = item->data(Qt::UserRole).toString().split(","); // Split the data string
-    if (fields.size() < 4) return; // Return if the data is invalid
+    const InventoryItem &item = inventory->item(current.row());
 
-    int equipped = fields[2].toInt(); // Get the equipped value
-    int attunement = fields[3].toInt(); // Get the attunement value
-
-    if(equipped == 1) // If the item is equipped, change text to "Unequip Item"
+    if(item.equipped) // If the item is equipped, change text to "Unequip Item"
     {
-        equipItemButton.setText("Unequip Item");
+        equipItemButton->setText("Unequip Item");
     }
     else // Otherwise, change text to "Equip Item"
     {
-        equipItemButton.setText("Equip Item");
+        equipItemButton->setText("Equip Item");
     }
-    if(attunement == 1) // If the item is attuned, change text to "Unattune Item"
+    if(item.attuned) // If the item is attuned, change text to "Unattune Item"
     {
-        attuneItemButton.setText("Unattune Item");
+        attuneItemButton->setText("Unattune Item");
     }
     else // Otherwise, change text to "Attune Item"
     {
-        attuneItemButton.setText("Attune Item");
+        attuneItemButton->setText("Attune Item");
     }
 }
 
@@ -202,8 +174,8 @@ void ViewInventory::deleteSelectedItem() {
     inventoryList->clearSelection();
     inventoryList->clearFocus();
 
-    QListWidgetItem *selectedItem = inventoryList->currentItem();
-    if (selectedItem) {
+    QModelIndex selectedItem = inventoryList->currentIndex();
+    if (selectedItem.isValid()) {
         // Create a confirmation popup
         QMessageBox::StandardButton reply = QMessageBox::question(
             this, 
@@ -214,8 +186,7 @@ void ViewInventory::deleteSelectedItem() {
 
         if (reply == QMessageBox::Yes) {
             // If user confirms, delete the item
-            delete inventoryList->takeItem(inventoryList->row(selectedItem)); // Remove the item from the list
-            saveInventory(); // Save the updated inventory
+            inventory->removeItem(selectedItem.row()); // Remove the item from the list
             QMessageBox::information(this, "Item Deleted", "The item has been successfully deleted.");
         }
     } else {
@@ -226,62 +197,19 @@ void ViewInventory::deleteSelectedItem() {
 
 void ViewInventory::increaseItemQuantity()
 {
-    QListWidgetItem *item = inventoryList->currentItem();
-    if (!item) return;
-
-    QStringList fields = item->data(Qt::UserRole).toString().split(",");
-    if (fields.size() < 4) return;
+    QModelIndex current = inventoryList->currentIndex();
+    if (!current.isValid()) return;
 
-    int quantity = fields[1].toInt();
-    fields[1] = QString::number(quantity + 1);
-
-    item->setText(fields[0] + " (x" + fields[1] + ")");
-    item->setData(Qt::UserRole, fields.join(",")); // Update UserRole data
-    saveInventory(); // Save changes to CSV immediately
+    inventory->setQuantity(current.row(), inventory->item(current.row()).quantity + 1);
 }
 
 void ViewInventory::decreaseItemQuantity()
 {
-    QListWidgetItem *item = inventoryList->currentItem();
-    if (!item) return;
-
-    QStringList fields = item->data(Qt::UserRole).toString().split(",");
-    if (fields.size() < 4) return;
-
-    int quantity = fields[1].toInt();
-    if (quantity > 1) {
-        fields[1] = QString::number(quantity - 1);
-
-        item->setText(fields[0] + " (x" + fields[1] + ")");
-        item->setData(Qt::UserRole, fields.join(",")); // Update UserRole data
-        saveInventory(); // Save changes to CSV immediately
-    }
-}
-
-
-
-void ViewInventory::saveInventory()
-{
-    QString characterName = inventoryLabel->text().remove("'s Inventory");
-    QString filePath = QDir::currentPath() + "/data/characters/" + characterName + "/inventory.csv";
+    QModelIndex current = inventoryList->currentIndex();
+    if (!current.isValid()) return;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open inventory file for saving:" << filePath;
-        return;
-    }
-
-    QTextStream out(&file);
-
-    for (int i = 0; i < inventoryList->count(); ++i) {
-        QListWidgetItem *item = inventoryList->item(i);
-        QString itemData = item->data(Qt::UserRole).toString(); // Retrieve full data
-        out << itemData << "\n"; // Write each item's data to the CSV
-    }
-    
-    file.close();
-    
-    loadInventory(); // Reload the inventory after saving
+    // Quantities stop at 1, deleting the item removes it
+    inventory->setQuantity(current.row(), inventory->item(current.row()).quantity - 1);
 }
 
 void ViewInventory::addItem() {
@@ -302,6 +230,9 @@ void ViewInventory::addItem() {
     // make item label and textbox
     QLabel *itemNameLabel = new QLabel("Item Name:");
     QLineEdit *itemNameEdit = new QLineEdit();
+    const ItemCompendium &items = ReferenceDatabase::instance().itemCompendium();
+    FuzzyCompleter *completer = new FuzzyCompleter(items.names(), &popup);
+    completer->attach(itemNameEdit);
     layout.addWidget(itemNameLabel);
     layout.addWidget(itemNameEdit);
 
@@ -339,86 +270,45 @@ void ViewInventory::addItem() {
         qDebug() << "Add Item";
 
         // get the item name and quantity
-        QString itemName = itemNameEdit->text();
+        QString itemName = itemNameEdit->text().trimmed();
         int quantity = quantityEdit->value();
 
-        // create the item string
-        QListWidgetItem *item = new QListWidgetItem(itemName + " (x" + QString::number(quantity) + ")");
-        item->setData(Qt::UserRole, itemName + "," + QString::number(quantity) + ",0,0");
-        inventoryList->addItem(item);
-    
-        saveInventory();
+        // Use the compendium's spelling for known items, anything else is kept as typed
+        int id = items.find(itemName);
+        if (id >= 0) {
+            itemName = items.item(id).name;
+        }
+
+        // add the item to the inventory
+        InventoryItem item;
+        item.name = itemName;
+        item.quantity = quantity;
+        inventory->addItem(item);
     }
 
 }
 
 void ViewInventory::equipItem() {
-    QListWidgetItem *item = inventoryList->currentItem();
-    if (!item) return;
-
-    QStringList fields = item->data(Qt::UserRole).toString().split(",");
-    if (fields.size() < 4) return;
-
-    int equipped = fields[2].toInt();
-    int attunement = fields[3].toInt();
-
-    if (equipped == 0) {
-        fields[2] = "1";
-        // QMessageBox::information(this, "Item Equipped", "Item has been equipped.");
-    } else {
-        fields[2] = "0";
+    QModelIndex current = inventoryList->currentIndex();
+    if (!current.isValid()) return;
 
-        if (attunement == 1) {
-            fields[3] = "0";
-            // QMessageBox::information(this, "Item Unequipped and Unattuned", "Item was unequipped and is no longer attuned.");
-        } else {
-            // QMessageBox::information(this, "Item Unequipped", "Item has been unequipped.");
-        }
-    }
-
-    item->setData(Qt::UserRole, fields.join(",")); // Update UserRole data
-    saveInventory(); // Save changes to CSV immediately
+    // Unequipping an item also ends its attunement
+    inventory->setEquipped(current.row(), !inventory->item(current.row()).equipped);
 }
 
 void ViewInventory::attuneItem() {
-    QListWidgetItem *item = inventoryList->currentItem();
-    if (!item) return;
-
-    QStringList fields = item->data(Qt::UserRole).toString().split(",");
-    if (fields.size() < 4) return;
+    QModelIndex current = inventoryList->currentIndex();
+    if (!current.isValid()) return;
 
-    int attunement = fields[3].toInt();
-    int equipped = fields[2].toInt();
-    int attunedItems = 0;
-
-    if (equipped == 0) {
+    const InventoryItem &item = inventory->item(current.row());
+    if (!item.equipped) {
         QMessageBox::warning(this, "Item Not Equipped", "You must equip the item before attuning to it.");
         return;
     }
 
-    if (attunement == 0) {
-        for (int i = 0; i < inventoryList->count(); ++i) {
-            QStringList itemFields = inventoryList->item(i)->data(Qt::UserRole).toString().split(",");
-            if (itemFields.size() >= 4 && itemFields[3].toInt() == 1) {
-                attunedItems++;
-            }
-        }
-
-        if (attunedItems >= 3) {
-            QMessageBox::warning(this, "Too Many Attuned Items", "You can only attune to 3 items at a time.");
-            return;
-        }
-
-        fields[3] = QString::number(attunement == 0 ? 1 : 0);
-        // QMessageBox::information(this, "Item Attuned", "Item has been attuned.");
-
-    } else {
-        fields[3] = "0";
-        // QMessageBox::information(this, "Item Unattuned", "Item has been unattuned.");
+    if (!inventory->setAttuned(current.row(), !item.attuned)) {
+        QMessageBox::warning(this, "Too Many Attuned Items", "You can only attune to 3 items at a time.");
     }
-
-    item->setData(Qt::UserRole, fields.join(",")); // Update UserRole data
-    saveInventory(); // Save changes to CSV immediately
 }
 
 
@@ -1,32 +1,39 @@
 /*
 Name: viewInventory.h
 Description: Page to view a character's inventory.
-Authors: Zachary Craig, Carson Treece
+Authors: Zachary Craig, Carson Treece, Josh Park
 Other Sources: ...
 Date Created: 11/5/2024
-Last Modified: 12/4/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef VIEWINVENTORY_H
 #define VIEWINVENTORY_H
 
 #include <QWidget>
-#include <QListWidget>
+#include <QListView>
 #include <QLabel>
 #include <QPushButton>
 
+class InventoryModel;
+
 class ViewInventory : public QWidget
 {
     Q_OBJECT
 public:
-    explicit ViewInventory(QWidget *parent = 0, QString name = "");
+    // The inventory model belongs to the character sheet, which loads and saves it
+    explicit ViewInventory(QWidget *parent = 0, QString name = "", InventoryModel *inventory = nullptr);
     ~ViewInventory();
+    void setStrength(int score); // Strength score that the carrying limits are based on
 
 private:
     QLabel *inventoryLabel; // Label for the character's inventory name
-    QListWidget *inventoryList; // List widget for displaying inventory items
-    void loadInventory(); // Load inventory from file
-    void saveInventory(); // Save inventory to file
+    QListView *inventoryList; // List view for displaying inventory items
+    InventoryModel *inventory; // The items, shared with the character sheet
+    QPushButton *equipItemButton;
+    QPushButton *attuneItemButton;
+    QLabel *weightLabel; // Carried weight and encumbrance
+    int strength = 10;
 
 private slots:
     void goBack(); // Navigate back to the previous screen
@@ -36,7 +43,8 @@ private slots:
     void addItem(); // Add a new item to the inventory
     void equipItem(); // Equip the selected item
     void attuneItem(); // Attune the selected item
-    void updateButtons(QPushButton &equipItemButton, QPushButton &attuneItemButton); // Update button states based on selected item
+    void updateButtons(); // Update button states based on selected item
+    void updateWeight(); // Show the model's carried weight against the character's limits
 };
 
 #endif
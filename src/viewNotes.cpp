@@ -1,14 +1,17 @@
 /*
 Name: viewNotes.cpp
 Description: Page to view a character's notes.
-Authors: Zachary Craig
+Authors: Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 11/18/2024
-Last Modified: 11/18/2024
+Last Modified: 10/17/2026
 */
 
 #include "viewNotes.h"
 #include "themeUtils.h"
+#include "notesStore.h"
+#include "characterStorage.h"
+#include "autosaveEngine.h"
 
 #include <QVBoxLayout>
 #include <QPushButton>
@@ -104,49 +107,24 @@ void ViewNotes::removeDeleteButton()
 
 void ViewNotes::loadNotes()
 {
+    // Save the open note first, the notes are read again below and the editor is cleared
+    saveCurrentNote();
     noteEdit->setEnabled(false); // Disable the text edit by default
 
-    // Get the path to the notes file
-    QString notesPath = QDir::currentPath() + "/data/characters/" + name + "/notes.json";
-
-    qDebug() << notesPath;
-
-    // Open the notes file
-    QFile notesFile(notesPath);
-    if (!notesFile.open(QIODevice::ReadOnly))
-    {
-        qDebug() << "Failed to open notes file";
-        return;
-    }
-
-    // Parse the notes file
-    QByteArray notesData = notesFile.readAll();
-    notesFile.close();
-
-    QJsonDocument notesDoc = QJsonDocument::fromJson(notesData);
-    if(!notesDoc.isObject())
+    // Read the notes file and any edits saved after it
+    notes = NotesStore(name);
+    if (!notes.load())
     {
-        qDebug() << "Failed to parse notes file";
         return;
     }
 
-    QJsonObject notesObj = notesDoc.object();
-    QJsonArray notesArr = notesObj["notes"].toArray();
-
     notesList->clear(); // Clear the notes list
     currentSection = ""; // Reset the current section
-    noteEdit->clear(); // Clear the current note
+    autosave->begin(QString());
+    noteEdit->loadText(QString()); // Clear the current note
 
     // Add each note to the list
-    for(const QJsonValue &note : notesArr)
-    {
-        QJsonObject noteObj = note.toObject();
-        QString noteSection = noteObj["section"].toString();
-        if(!noteSection.isEmpty())
-        {
-            notesList->addItem(noteSection);
-        }
-    }
+    notesList->addItems(notes.sections());
 
     // Add a create a note button to the list
     notesList->addItem("Create a New Note");
@@ -161,6 +139,9 @@ void ViewNotes::onNoteSelected(QListWidgetItem *item)
 
     if (sectionName == "Create a New Note")
     {
+        // Save the open note before the list is changed under it
+        saveCurrentNote();
+
         // Replace the create a new note button with an editable field and checkmark
         QWidget *newNoteWidget = new QWidget();
         QHBoxLayout *newNoteLayout = new QHBoxLayout(newNoteWidget);
@@ -216,204 +197,61 @@ void ViewNotes::onNoteSelected(QListWidgetItem *item)
     // Save the current note before switching
     saveCurrentNote();
 
-    // Get the path to the notes file
-    QString notesPath = QDir::currentPath() + "/data/characters/" + name + "/notes.json";
-
-    // Open the notes file
-    QFile notesFile(notesPath);
-    if (!notesFile.open(QIODevice::ReadOnly))
-    {
-        qDebug() << "Failed to open notes file";
-        return;
-    }
-
-    // Parse the notes file
-    QByteArray notesData = notesFile.readAll();
-    notesFile.close(); // Close the file after reading
-
-    QJsonDocument notesDoc = QJsonDocument::fromJson(notesData); // Parse the JSON data
-    if (!notesDoc.isObject())
-    {
-        qDebug() << "Failed to parse notes file"; // Log an error if parsing fails
-        return;
-    }
-
-    QJsonObject notesObj = notesDoc.object(); // Get the JSON object
-    QJsonArray notesArr = notesObj["notes"].toArray(); // Get the notes array
-
     // Find the note corresponding to the new section
-    for (const QJsonValue &note : notesArr)
+    if (notes.contains(newSectionName))
     {
-        QJsonObject noteObj = note.toObject();
-        if (noteObj["section"].toString() == newSectionName)
-        {
-            // Populate the noteEdit with the corresponding notes content
-            noteEdit->setText(noteObj["notes"].toString());
-            noteEdit->setEnabled(true); // Enable the text edit for editing
-            currentSection = newSectionName; // Update the current section
-            addDeleteButton(); // Add the delete button to the layout
-            return;
-        }
+        // Populate the noteEdit with the corresponding notes content, autosave starts once it is all in
+        currentSection = newSectionName; // Update the current section
+        autosave->begin(QString());
+        noteEdit->loadText(notes.text(newSectionName));
+        noteEdit->setEnabled(true); // Enable the text edit for editing
+        addDeleteButton(); // Add the delete button to the layout
+        return;
     }
 
     // If no match is found, clear the noteEdit and reset currentSection
-    noteEdit->clear();
     currentSection = "";
+    noteEdit->loadText(QString());
 }
 
-void ViewNotes::saveCurrentNote()
+void ViewNotes::openSection(const QString &section, int offset, int length)
 {
-    // Skip saving if there's no current section
-    if (currentSection.isEmpty())
-    {
-        return;
-    }
-
-    // Get the path to the notes file
-    QString notesPath = QDir::currentPath() + "/data/characters/" + name + "/notes.json";
-
-    // Open the notes file
-    QFile notesFile(notesPath);
-    if (!notesFile.open(QIODevice::ReadWrite))
+    // Find the section in the list, the notes may have changed since the search index saw them
+    QList<QListWidgetItem *> items = notesList->findItems(section, Qt::MatchExactly);
+    if (items.isEmpty())
     {
-        qDebug() << "Failed to open notes file for writing";
+        qDebug() << "Note section not found:" << section;
         return;
     }
 
-    // Parse the JSON file
-    QByteArray notesData = notesFile.readAll();
-    notesFile.close();
-
-    QJsonDocument notesDoc = QJsonDocument::fromJson(notesData);
-    if (!notesDoc.isObject())
+    notesList->setCurrentItem(items.first());
+    onNoteSelected(items.first());
+    if (currentSection != section)
     {
-        qDebug() << "Invalid JSON format";
         return;
     }
 
-    QJsonObject notesObj = notesDoc.object();
-    QJsonArray notesArr = notesObj["notes"].toArray();
-
-    // Update the note for the current section
-    for (int i = 0; i < notesArr.size(); ++i)
-    {
-        QJsonObject noteObj = notesArr[i].toObject();
-        if (noteObj["section"].toString() == currentSection)
-        {
-            noteObj["notes"] = noteEdit->toPlainText();
-            notesArr[i] = noteObj; // Save the modified object back to the array
-            break;
-        }
-    }
-
-    // Save the updated JSON back to the file
-    notesObj["notes"] = notesArr;
-    notesDoc.setObject(notesObj);
-
-    if (!notesFile.open(QIODevice::WriteOnly))
-    {
-        qDebug() << "Failed to reopen notes file for writing";
-        return;
-    }
+    // Select the matched text and scroll to it, a large section may still be loading
+    noteEdit->selectRange(offset, length);
+    noteEdit->setFocus();
+}
 
-    notesFile.write(notesDoc.toJson(QJsonDocument::Indented));
-    notesFile.close();
-    qDebug() << "Notes saved for section:" << currentSection;
+void ViewNotes::saveCurrentNote()
+{
+    // Writes the current note only if it was edited since it was last saved
+    autosave->flush();
 }
 
 void ViewNotes::createNewNote(const QString &newNoteName)
 {
-    QString notesPath = QDir::currentPath() + "/data/characters/" + name + "/notes.json";
-
-    QFile notesFile(notesPath);
-    if (!notesFile.open(QIODevice::ReadWrite))
-    {
-        qDebug() << "Failed to open notes file for writing";
-        return;
-    }
-
-    // Parse the JSON file
-    QByteArray notesData = notesFile.readAll();
-    notesFile.close();
-
-    QJsonDocument notesDoc = QJsonDocument::fromJson(notesData);
-    if (!notesDoc.isObject())
-    {
-        qDebug() << "Invalid JSON format";
-        return;
-    }
-
-    QJsonObject notesObj = notesDoc.object();
-    QJsonArray notesArr = notesObj["notes"].toArray();
-
-    // Add the new note
-    QJsonObject newNote;
-    newNote["section"] = newNoteName;
-    newNote["notes"] = "";
-    newNote["lastUpdated"] = QDateTime::currentDateTime().toString("dd-MM-yyyy|hh:mm:ss");
-
-    notesArr.append(newNote);
-    notesObj["notes"] = notesArr;
-
-    // Write back to the file
-    notesDoc.setObject(notesObj);
-    if (!notesFile.open(QIODevice::WriteOnly))
-    {
-        qDebug() << "Failed to reopen notes file for writing";
-        return;
-    }
-
-    notesFile.write(notesDoc.toJson(QJsonDocument::Indented));
-    notesFile.close();
+    notes.create(newNoteName);
     qDebug() << "New note created:" << newNoteName;
 }
 
 void ViewNotes::deleteNoteSection(const QString &sectionName)
 {
-    QString notesPath = QDir::currentPath() + "/data/characters/" + name + "/notes.json";
-
-    QFile notesFile(notesPath);
-    if (!notesFile.open(QIODevice::ReadWrite))
-    {
-        qDebug() << "Failed to open notes file for deletion";
-        return;
-    }
-
-    QByteArray notesData = notesFile.readAll();
-    notesFile.close();
-
-    QJsonDocument notesDoc = QJsonDocument::fromJson(notesData);
-    if (!notesDoc.isObject())
-    {
-        qDebug() << "Invalid JSON format";
-        return;
-    }
-
-    QJsonObject notesObj = notesDoc.object();
-    QJsonArray notesArr = notesObj["notes"].toArray();
-
-    // Remove the note from the JSON array
-    for (int i = 0; i < notesArr.size(); ++i)
-    {
-        QJsonObject noteObj = notesArr[i].toObject();
-        if (noteObj["section"].toString() == sectionName) {
-            notesArr.removeAt(i);  // Remove the note
-            break;
-        }
-    }
-
-    // Save the updated JSON back to the file
-    notesObj["notes"] = notesArr;
-    notesDoc.setObject(notesObj);
-
-    if (!notesFile.open(QIODevice::WriteOnly))
-    {
-        qDebug() << "Failed to reopen notes file for writing";
-        return;
-    }
-
-    notesFile.write(notesDoc.toJson(QJsonDocument::Indented));
-    notesFile.close();
+    saveCurrentNote(); // Written before the removal so it lands in the journal ahead of it
+    notes.remove(sectionName);
     qDebug() << "Note deleted:" << sectionName;
 
     removeDeleteButton(); // Remove the delete button from the layout
@@ -426,12 +264,25 @@ ViewNotes::ViewNotes(QWidget *parent, QString name) :
 {
     this->name = name;
 
-    // Initialize the timer
-    saveTimer = new QTimer(this);
-    connect(saveTimer, &QTimer::timeout, this, &ViewNotes::saveCurrentNote);
+    // Save the open note after a pause in typing, or once an edit has waited too long
+    autosave = new AutosaveEngine([this](const QString &section)
+    {
+        // Only the part of the note that changed since the last save is copied out and written
+        LargeNoteEditor::Change change = noteEdit->takeChange();
+        if (!notes.replace(section, change.at, change.removed, change.insert))
+        {
+            // The span did not fit the saved note, comparing the whole text still saves what is on screen
+            qWarning() << "Note edit did not fit" << section << ", saving the whole note";
+            notes.setText(section, noteEdit->toPlainText());
+        }
+    }, this);
+    autosave->watch(noteEdit->document());
 
-    // Start the timer to trigger every 10 seconds (10,000 milliseconds)
-    saveTimer->start(10000);
+    // Edits count from when the section has finished loading
+    connect(noteEdit, &LargeNoteEditor::loaded, this, [this]()
+    {
+        autosave->begin(currentSection);
+    });
 
     // Create a row for the navbar
     QWidget *navbar = new QWidget();
@@ -500,8 +351,14 @@ ViewNotes::ViewNotes(QWidget *parent, QString name) :
 
 void ViewNotes::goBack()
 {
-    // Save the current note before going back
+    // Save the current note before going back, and fold the edits into the note records while the page is not in use
     saveCurrentNote();
+    if (notes.hasJournal())
+    {
+        notes.compact();
+    }
+    qDebug() << "Notes autosave for" << name << ":" << autosave->savesPerformed() << "saved,"
+             << autosave->savesSkipped() << "skipped";
     loadNotes();
     notesList->clearSelection();
     notesList->clearFocus();
@@ -519,9 +376,15 @@ void ViewNotes::goBack()
 
 ViewNotes::~ViewNotes()
 {
-    if (saveTimer->isActive())
+    // Save the last edits and fold them into the note records so the next open has no journal to replay,
+    // unless the character was deleted and the page is going with them
+    if (!CharacterStorage::instance().exists(name, "character.csv"))
+    {
+        return;
+    }
+    saveCurrentNote();
+    if (notes.hasJournal())
     {
-        saveTimer->stop();
+        notes.compact();
     }
-    delete saveTimer;
 }
\ No newline at end of file
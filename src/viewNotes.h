@@ -1,10 +1,10 @@
 /*
 Name: viewNotes.h
 Description: Header file for the viewNotes class, which displays a character's notes.
-Authors: Zachary Craig
+Authors: Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 11/18/2024
-Last Modified: 11/18/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef VIEWNOTES_H
@@ -12,22 +12,29 @@ Last Modified: 11/18/2024
 
 #include <QWidget>
 #include <QListWidget>
-#include <QTextEdit>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QPushButton>
 
+#include "notesStore.h"
+#include "largeNoteEditor.h"
+
+class AutosaveEngine;
+
 class ViewNotes : public QWidget
 {
 Q_OBJECT
 public:
     explicit ViewNotes(QWidget *parent = 0, QString name = "");
     ~ViewNotes();
+    // Selects a section and highlights length characters of it from offset, used by the notes search
+    void openSection(const QString &section, int offset = 0, int length = 0);
 
 private:
     QString name;
     QString currentSection;
-    QTimer *saveTimer;
+    NotesStore notes;
+    AutosaveEngine *autosave;
     void loadNotes();
     void onNoteSelected(QListWidgetItem *item);
     void saveCurrentNote();
@@ -39,7 +46,7 @@ private:
     QListWidget *notesList = new QListWidget();
     QWidget *notesListContainer = new QWidget();
     QVBoxLayout *notesListContainerLayout = new QVBoxLayout(notesListContainer);
-    QTextEdit *noteEdit = new QTextEdit();
+    LargeNoteEditor *noteEdit = new LargeNoteEditor();
     QPushButton *deleteButton = new QPushButton("Delete Note");
 
 private slots:
@@ -4,14 +4,22 @@ Description: Page to view a character's spells.
 Authors: Zachary Craig, Josh Park
 Other Sources: ...
 Date Created: 11/19/2024
-Last Modified: 12/3/2024
+Last Modified: 10/17/2026
 */
 
 #ifndef VIEWSPELLS_H
 #define VIEWSPELLS_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
+#include <QLabel>
+
+#include "spellSlotTable.h"
+
+class QComboBox;
+class QCheckBox;
+class SpellTableModel;
+class SpellSortFilterProxy;
 
 class ViewSpells : public QWidget
 {
@@ -21,31 +29,25 @@ public:
     ~ViewSpells();
 
 private:
-    QTableWidget * spells;
+    QTableView * spells;
+    SpellTableModel * spellModel;
+    SpellSortFilterProxy * spellProxy;
+    QComboBox * schoolFilter;
+    QCheckBox * concentrationFilter;
+    QCheckBox * ritualFilter;
+    QCheckBox * preparedFilter;
+    QComboBox * thenSortBy;
     QString name;
-    QString charPath;
+    QString charClass;
     int level;
-    int totalLevel1Slots;
-    int totalLevel2Slots;
-    int totalLevel3Slots;
-    int totalLevel4Slots;
-    int totalLevel5Slots;
-    int totalLevel6Slots;
-    int totalLevel7Slots;
-    int totalLevel8Slots;
-    int totalLevel9Slots;
-    int level1SlotsUsed;
-    int level2SlotsUsed;
-    int level3SlotsUsed;
-    int level4SlotsUsed;
-    int level5SlotsUsed;
-    int level6SlotsUsed;
-    int level7SlotsUsed;
-    int level8SlotsUsed;
-    int level9SlotsUsed;
+    // Indexed by spell level, [0] is unused so [1] is 1st level
+    int totalSlots[SpellSlotTable::maxSpellLevel + 1] = {};
+    int slotsUsed[SpellSlotTable::maxSpellLevel + 1] = {};
+    QLabel * slotLabels[SpellSlotTable::maxSpellLevel + 1] = {};
     int maxPrepared;
     void loadSpells();
-    void addItem(QString line);
+    void addSchool(const QString &school);
+    void updateSlotLabel(int level);
 
 public slots:
     void castSpell(int level);
@@ -53,6 +55,8 @@ private slots:
     void saveSpells();
     void saveSlots();
     void addSpell();
+    void filterSpells();
+    void sortSpellsBy();
     void goBack();
 };
 